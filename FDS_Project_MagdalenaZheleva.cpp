@@ -6,964 +6,8030 @@
 #include <iomanip>
 #include <algorithm>
 #include <limits>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <set>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <array>
+#include <coroutine>
+#include <optional>
+#include <charconv>
+#include <cmath>
+#include <bit>
+#include <filesystem>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef __linux__
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/resource.h>
+#include <malloc.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <sys/random.h>
+#endif
 using namespace std;
 
 
-// Base class for all types of items managed by GTN Manager
-class Item {
-public:
-    string title;
-    string description;
+// Appends a free-text field to a data.txt record. The format has no escaping, so separators
+// inside the text (commas, ';' in tags, line breaks) are replaced by spaces to keep the record loadable.
+void appendRecordField(string& out, const string& field, const char* separators = ",\r\n") {
+    // All separators are below 64, so a bit mask answers "is this a separator" without a search
+    uint64_t separatorMask = 0;
+    for (const char* c = separators; *c; c++) {
+        separatorMask |= 1ull << *c;
+    }
+    size_t start = out.size();
+    out += field;
+    for (char* c = &out[start], *end = c + field.size(); c != end; c++) {
+        unsigned char value = static_cast<unsigned char>(*c);
+        if (value < 64 && (separatorMask >> value) & 1) {
+            *c = ' ';
+        }
+    }
+}
 
-    // Constructor initializes title and description
-    Item(const string& title, const string& description) : title(title), description(description) {}
+// Appends a number to a data.txt record without going through a stream
+template <typename Number>
+void appendRecordNumber(string& out, Number value) {
+    char buffer[32];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value); // Shortest form that reads back exactly
+    out.append(buffer, result.ptr);
+}
 
-    // Pure virtual functions to be implemented by derived classes
-    virtual void display() const = 0;
-    virtual string getDetails() const = 0;
-  
-    // Virtual destructor for proper cleanup of derived classes
-    virtual ~Item() {} 
-};
 
+// Number of days in a month of the Gregorian calendar
+unsigned daysInMonth(int year, unsigned month) {
+    static const unsigned lengths[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : lengths[month - 1];
+}
 
-// Task class derived from Item for managing tasks
-class Task : public Item {
-public:
-    string deadline;
-    int priority;
+// Days since 1970-01-01 of a Gregorian date (Howard Hinnant's days_from_civil)
+int daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int>(dayOfEra) - 719468;
+}
 
-    // Constructor initializes Task attributes along with inherited attributes
-    Task(const string& title, const string& description, const string& deadline, int priority) :
-        Item(title, description), deadline(deadline), priority(priority) {}
+// Inverse of daysFromCivil
+void civilFromDays(int days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = static_cast<int>(yearOfEra) + era * 400 + (month <= 2);
+}
 
-    // Displays task information
-    void display() const override {
-        cout << "Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << endl;
+// Parses a "YYYY-MM-DD" deadline into days since 1970-01-01; false for anything else (e.g. "No deadline")
+bool parseDate(const string& text, int& days) {
+    int year = 0;
+    unsigned month = 0, day = 0;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-' ||
+        from_chars(text.data(), text.data() + 4, year).ptr != text.data() + 4 ||
+        from_chars(text.data() + 5, text.data() + 7, month).ptr != text.data() + 7 ||
+        from_chars(text.data() + 8, text.data() + 10, day).ptr != text.data() + 10 ||
+        month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
     }
+    days = daysFromCivil(year, month, day);
+    return true;
+}
 
-    // Returns task details as a formatted string
-    string getDetails() const override {
-        return "Title: " + title + "\nDescription: " + description + "\nDeadline: " + deadline + "\nPriority: " + to_string(priority);
-    }
-};
+// Formats days since 1970-01-01 as "YYYY-MM-DD"
+string formatDate(int days) {
+    int year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", year, month, day);
+    return buffer;
+}
 
+// Today's local date in days since 1970-01-01
+int currentDay() {
+    time_t now = time(nullptr);
+    tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return daysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1), static_cast<unsigned>(local.tm_mday));
+}
 
-// Specialized Task class for recurring tasks
-class RecurringTask : public Task {
-public:
-    string recurrenceInterval;
+// Allocation tracking: global operator new/delete are replaced so that, while tracking is switched
+// on, every heap allocation is counted for the calling thread and for the innermost instrumented
+// operation (TIME_OPERATION) active on it. Tracking is off unless --track-allocations is given or
+// an allocation budget is being checked, so normal runs pay one relaxed load per allocation.
+// Build with -DGTN_ALLOCATION_TRACKING=0 to keep the standard operators.
+#ifndef GTN_ALLOCATION_TRACKING
+#define GTN_ALLOCATION_TRACKING 1
+#endif
 
-    RecurringTask(const string& title, const string& description, const string& deadline, int priority, const string& interval) :
-        Task(title, description, deadline, priority), recurrenceInterval(interval) {}
+struct OperationAllocations {
+    atomic<uint64_t> scopes { 0 }; // Times the operation ran while tracking was on
+    atomic<uint64_t> allocations { 0 };
+    atomic<uint64_t> bytes { 0 };
+    atomic<uint64_t> frees { 0 };
+};
 
-    void display() const override {
-        cout << "Recurring Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << ", Interval: " << recurrenceInterval << endl;
+struct AllocationCount {
+    uint64_t allocations, bytes;
+};
+
+atomic<int> allocationTrackingUsers(0); // Tracking is on while this is positive
+OperationAllocations unattributedAllocations; // Allocations outside every instrumented operation
+thread_local OperationAllocations* currentAllocationScope = nullptr;
+thread_local uint64_t threadAllocations = 0, threadAllocatedBytes = 0;
+
+#if GTN_ALLOCATION_TRACKING
+void* operator new(size_t size) {
+    if (allocationTrackingUsers.load(memory_order_relaxed) > 0) {
+        OperationAllocations& counters = currentAllocationScope ? *currentAllocationScope : unattributedAllocations;
+        counters.allocations.fetch_add(1, memory_order_relaxed);
+        counters.bytes.fetch_add(size, memory_order_relaxed);
+        threadAllocations++;
+        threadAllocatedBytes += size;
+    }
+    while (true) {
+        if (void* block = malloc(size ? size : 1)) {
+            return block;
+        }
+        new_handler handler = get_new_handler();
+        if (!handler) {
+            throw bad_alloc();
+        }
+        handler();
     }
+}
 
-    string getDetails() const override {
-        return Task::getDetails() + "\nRecurrence Interval: " + recurrenceInterval;
+void operator delete(void* block) noexcept {
+    if (block && allocationTrackingUsers.load(memory_order_relaxed) > 0) {
+        (currentAllocationScope ? *currentAllocationScope : unattributedAllocations).frees.fetch_add(1, memory_order_relaxed);
     }
-};
+    free(block);
+}
 
+void operator delete(void* block, size_t) noexcept {
+    operator delete(block);
+}
+#endif
 
-// Specialized Task class for one-time tasks
-class OneTimeTask : public Task {
+// Allocations of the rest of the scope count as outside every operation; used by the registries,
+// whose first-use setup is not the cost of the operation that happens to trigger it
+class UnattributedAllocations {
 public:
-    OneTimeTask(const string& title, const string& description, const string& deadline, int priority) :
-        Task(title, description, deadline, priority) {}
-
-    void display() const override {
-        cout << "One-Time Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << endl;
+    UnattributedAllocations() : previous(currentAllocationScope) {
+        currentAllocationScope = nullptr;
     }
 
-    string getDetails() const override {
-        return Task::getDetails();
+    ~UnattributedAllocations() {
+        currentAllocationScope = previous;
     }
-};
 
+private:
+    OperationAllocations* previous;
+};
 
-// Note class derived from Item for managing notes
-class Note : public Item {
+// Allocation counters of each instrumented operation
+class AllocationStats {
 public:
-    vector<string> tags;// Tags associated with the note
-
-    Note(const string& title, const string& description, const vector<string>& tags) :
-        Item(title, description), tags(tags) {}
+    OperationAllocations& operation(const string& name) {
+        UnattributedAllocations unattributed;
+        lock_guard<mutex> lock(statsMutex);
+        unique_ptr<OperationAllocations>& slot = operations[name];
+        if (!slot) {
+            slot.reset(new OperationAllocations());
+        }
+        return *slot;
+    }
 
-    // Display basic note information along with tags
-    void display() const override {
-        cout << "Note: " << title << " [Tags: ";
-        for (const auto& tag : tags) {
-            cout << tag << " ";
+    void display() const {
+        lock_guard<mutex> lock(statsMutex);
+        cout << left << setw(32) << "Operation" << right << setw(8) << "Runs" << setw(14) << "Allocs/run" << setw(14) << "Bytes/run" << setw(12) << "Frees/run" << "\n";
+        for (const auto& entry : operations) {
+            displayRow(entry.first, *entry.second);
         }
-        cout << "]" << endl;
+        displayRow("(outside operations)", unattributedAllocations);
+        cout << left;
     }
 
-    // Returns detailed information about the note including all tags
-    string getDetails() const override {
-        string details = "Title: " + title + "\nDescription: " + description + "\nTags: ";
-        for (const auto& tag : tags) {
-            details += tag + ", ";
+private:
+    static void displayRow(const string& name, const OperationAllocations& counters) {
+        uint64_t runs = counters.scopes.load(), allocations = counters.allocations.load();
+        if (runs == 0 && allocations == 0) {
+            return;
         }
-        // Remove trailing comma and space from tags list
-        details.pop_back(); // Remove the last comma
-        details.pop_back(); // Remove the last space
-        return details;
+        double perRun = static_cast<double>(max<uint64_t>(1, runs));
+        cout << left << setw(32) << name << right << setw(8) << runs << fixed << setprecision(1) << setw(14) << allocations / perRun
+            << setw(14) << counters.bytes.load() / perRun << setw(12) << counters.frees.load() / perRun << "\n";
     }
+
+    mutable mutex statsMutex;
+    map<string, unique_ptr<OperationAllocations>> operations;
 };
 
-// ProtectedNote class for notes that require a password to access
-class ProtectedNote : public Note {
+AllocationStats& allocationStats() {
+    static AllocationStats stats;
+    return stats;
+}
+
+// Makes the operation the target of the thread's allocations for the rest of the scope
+class AllocationScope {
 public:
-    string password; // Password for accessing the note
+    AllocationScope(OperationAllocations& operation) : previous(currentAllocationScope) {
+        if (allocationTrackingUsers.load(memory_order_relaxed) > 0) {
+            operation.scopes.fetch_add(1, memory_order_relaxed);
+        }
+        currentAllocationScope = &operation;
+    }
 
-    ProtectedNote(const string& title, const string& description, const vector<string>& tags, const string& password) :
-        Note(title, description, tags), password(password) {}
+    ~AllocationScope() {
+        currentAllocationScope = previous;
+    }
 
-    void display() const override {
-        cout << "Protected Note: " << title << " [Protected]" << endl;
+private:
+    OperationAllocations* previous;
+};
+
+// Switches tracking on for the lifetime of the object (nestable)
+class AllocationTracking {
+public:
+    AllocationTracking() {
+        allocationTrackingUsers++;
     }
 
-    string getDetails() const override {
-        return Note::getDetails() + "\nPassword Protected";
+    ~AllocationTracking() {
+        allocationTrackingUsers--;
     }
 };
 
-// PublicNote class for notes that are publicly accessible
-class PublicNote : public Note {
+// Allocations made by the calling thread while body runs
+AllocationCount allocationsDuring(const function<void()>& body) {
+    AllocationTracking tracking;
+    uint64_t allocations = threadAllocations, bytes = threadAllocatedBytes;
+    body();
+    return { threadAllocations - allocations, threadAllocatedBytes - bytes };
+}
+
+// Allocation budget check for tests: runs body once to warm up, then `runs` more times, and
+// passes if no run made more than maxAllocations allocations. Prints the measured worst case.
+bool checkAllocationBudget(const string& name, const function<void()>& body, uint64_t maxAllocations, int runs = 10) {
+    body();
+    AllocationCount worst = { 0, 0 };
+    for (int i = 0; i < runs; i++) {
+        AllocationCount count = allocationsDuring(body);
+        if (count.allocations > worst.allocations) {
+            worst = count;
+        }
+    }
+    bool passed = GTN_ALLOCATION_TRACKING == 0 || worst.allocations <= maxAllocations;
+    cout << left << setw(40) << name << right << setw(10) << worst.allocations << " allocs" << setw(12) << worst.bytes << " bytes   budget "
+        << setw(8) << maxAllocations << (passed ? "   PASS" : "   FAIL") << left << endl;
+    return passed;
+}
+
+// Latency histogram with HDR-style log-linear buckets: 32 sub-buckets per power of two keep every
+// recorded value within about 3% of its bucket, from 1 ns up to the full 64-bit range.
+// Recording is lock-free, so timers can run on any thread.
+class LatencyHistogram {
 public:
-    PublicNote(const string& title, const string& description, const vector<string>& tags) :
-        Note(title, description, tags) {}
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
 
-    // Display public note information
-    void display() const override {
-        cout << "Public Note: " << title << " [Tags: ";
-        for (const auto& tag : tags) {
-            cout << tag << " ";
+    void record(uint64_t nanoseconds) {
+        counts[bucketOf(nanoseconds)].fetch_add(1, memory_order_relaxed);
+        total.fetch_add(1, memory_order_relaxed);
+        uint64_t seen = maximum.load(memory_order_relaxed);
+        while (nanoseconds > seen && !maximum.compare_exchange_weak(seen, nanoseconds, memory_order_relaxed)) {
         }
-        cout << "]" << endl;
     }
 
-    // Returns details of the public note
-    string getDetails() const override {
-        return Note::getDetails();
+    uint64_t count() const {
+        return total.load(memory_order_relaxed);
     }
-};
 
+    uint64_t max() const {
+        return maximum.load(memory_order_relaxed);
+    }
 
-// Goal base class derived from Item, for managing goals with a progress attribute
-class Goal : public Item {
-protected:
-    double progress;// Progress percentage of the goal
+    // Highest value that falls in the same bucket as the given percentile (0-100)
+    uint64_t percentile(double percent) const {
+        uint64_t recorded = count();
+        if (recorded == 0) {
+            return 0;
+        }
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(ceil(percent / 100 * recorded)));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts[i].load(memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(highestInBucket(i), max());
+            }
+        }
+        return max();
+    }
 
-public:
-    Goal(const string& title, const string& description, double progress) : Item(title, description), progress(progress) {}
+private:
+    static int bucketOf(uint64_t value) {
+        if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+            return static_cast<int>(value);
+        }
+        int exponent = bit_width(value) - 1;
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    }
 
-    // Display goal information including progress percentage
-    virtual void display() const override {
-        cout << "Goal: " << title << ", Progress: " << fixed << setprecision(0) << progress * 100 << "%" << endl;
+    static uint64_t highestInBucket(int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        int shift = bucket / SUB_BUCKETS - 1;
+        uint64_t lowest = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+        return lowest + ((uint64_t(1) << shift) - 1);
     }
-    // Returns details of the goal including formatted progress
-    virtual string getDetails() const override {
-        return "Title: " + title + "\nDescription: " + description + "\nProgress: " + to_string(static_cast<int>(progress * 100)) + "%";
+
+    array<atomic<uint64_t>, BUCKET_COUNT> counts {};
+    atomic<uint64_t> total { 0 };
+    atomic<uint64_t> maximum { 0 };
+};
+
+// "850 ns", "12.4 us", "3.21 ms" or "1.05 s"
+string formatLatency(uint64_t nanoseconds) {
+    ostringstream out;
+    out << fixed << setprecision(nanoseconds < 1000 ? 0 : 2);
+    if (nanoseconds < 1000) {
+        out << nanoseconds << " ns";
     }
-    // Returns the current progress of the goal
-    virtual double getProgress() const {
-        return progress;
+    else if (nanoseconds < 1000000) {
+        out << nanoseconds / 1e3 << " us";
     }
-};
+    else if (nanoseconds < 1000000000) {
+        out << nanoseconds / 1e6 << " ms";
+    }
+    else {
+        out << nanoseconds / 1e9 << " s";
+    }
+    return out.str();
+}
 
-// QuantifiableGoal class derived from Goal for goals that have quantifiable progress
-class QuantifiableGoal : public Goal {
+// Latency histograms of the session, one per named operation
+class LatencyStats {
 public:
-    QuantifiableGoal(const string& title, const string& description, double progress) : Goal(title, description, progress) {}
-
-    void display() const override {
-        cout << "Quantifiable Goal: " << title << ", Progress: " << fixed << setprecision(0) << progress * 100 << "%" << endl;
+    // The histogram stays at the same address for the life of the program
+    LatencyHistogram& histogram(const string& operation) {
+        UnattributedAllocations unattributed;
+        lock_guard<mutex> lock(statsMutex);
+        unique_ptr<LatencyHistogram>& slot = histograms[operation];
+        if (!slot) {
+            slot.reset(new LatencyHistogram());
+        }
+        return *slot;
     }
 
-    string getDetails() const override {
-        return Goal::getDetails();
+    void display() const {
+        lock_guard<mutex> lock(statsMutex);
+        cout << left << setw(32) << "Operation" << right << setw(8) << "Count" << setw(12) << "p50" << setw(12) << "p99" << setw(12) << "Max" << "\n";
+        for (const auto& entry : histograms) {
+            const LatencyHistogram& histogram = *entry.second;
+            if (histogram.count() == 0) {
+                continue;
+            }
+            cout << left << setw(32) << entry.first << right << setw(8) << histogram.count() << setw(12) << formatLatency(histogram.percentile(50))
+                << setw(12) << formatLatency(histogram.percentile(99)) << setw(12) << formatLatency(histogram.max()) << "\n";
+        }
+        cout << left;
     }
 
-    double getProgress() const override {
-        return progress;
-    }
+private:
+    mutable mutex statsMutex;
+    map<string, unique_ptr<LatencyHistogram>> histograms;
 };
 
-// NonQuantifiableGoal class for goals where progress is not quantified
-class NonQuantifiableGoal : public Goal {
+LatencyStats& latencyStats() {
+    static LatencyStats stats;
+    return stats;
+}
+
+// Hardware performance counters: with --perf-counters (or the "perf" command), every instrumented
+// operation also reads cycles, instructions, last-level cache misses and branch misses of the
+// calling thread through perf_event_open, plus the task clock and page faults as software counters.
+// Each counter is opened on its own, so when the kernel refuses some of them (no PMU exposed in a
+// VM or container, perf_event_paranoid, seccomp) the others are still reported and the missing ones
+// show as n/a. Linux only; build with -DGTN_PERF_COUNTERS=0 to compile the reads out.
+#ifndef GTN_PERF_COUNTERS
+#ifdef __linux__
+#define GTN_PERF_COUNTERS 1
+#else
+#define GTN_PERF_COUNTERS 0
+#endif
+#endif
+
+enum PerfCounter { PERF_CYCLES, PERF_INSTRUCTIONS, PERF_LLC_MISSES, PERF_BRANCH_MISSES, PERF_TASK_CLOCK, PERF_PAGE_FAULTS, PERF_COUNTER_COUNT };
+
+// Raw counts of the counter group, with the times the group was enabled and actually counting
+struct PerfReading {
+    uint64_t values[PERF_COUNTER_COUNT] = {};
+    uint64_t enabled = 0, running = 0;
+};
+
+atomic<bool> perfProfiling(false);
+
+#if GTN_PERF_COUNTERS
+// The counters of one thread, opened on its first instrumented operation as a single group: the
+// kernel schedules them together, and one read() returns all of them with the group's times
+class PerfCounters {
 public:
-    NonQuantifiableGoal(const string& title, const string& description, double progress) : Goal(title, description, progress) {}
+    PerfCounters() : leader(-1), memberCount(0) {
+        static const pair<uint32_t, uint64_t> events[PERF_COUNTER_COUNT] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+        };
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            perf_event_attr attributes;
+            memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = events[c].first;
+            attributes.config = events[c].second;
+            attributes.exclude_kernel = 1; // Allowed up to perf_event_paranoid 2
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // The first counter that opens leads the group; the others join it in order
+            fds[c] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+            errors[c] = fds[c] < 0 ? errno : 0;
+            if (fds[c] >= 0) {
+                leader = leader < 0 ? fds[c] : leader;
+                members[memberCount++] = c;
+            }
+        }
+    }
 
-    void display() const override {
-        cout << "Non-Quantifiable Goal: " << title << " - Progress not quantified." << endl;
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
     }
 
-    string getDetails() const override {
-        return Goal::getDetails() + "\nNon-quantifiable progress";
+    // Reads the raw, cumulative counts; scaling happens on differences (see delta)
+    void read(PerfReading& reading) const {
+        uint64_t raw[3 + PERF_COUNTER_COUNT]; // Member count, time enabled, time running, values in join order
+        if (leader < 0 || ::read(leader, raw, sizeof(raw)) < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+            return;
+        }
+        reading.enabled = raw[1];
+        reading.running = raw[2];
+        for (int m = 0; m < memberCount && m < static_cast<int>(raw[0]); m++) {
+            reading.values[members[m]] = raw[3 + m];
+        }
     }
 
-    double getProgress() const override {
-        // Return a special value indicating non-quantifiability
-        return -1.0;
+    // Count of a counter between two readings. When the group was multiplexed with other events,
+    // the raw difference is scaled by the enabled/running times of the same interval; scaling the
+    // cumulative values instead could make the end smaller than the start.
+    static uint64_t delta(const PerfReading& start, const PerfReading& end, int counter) {
+        uint64_t value = end.values[counter] - start.values[counter];
+        uint64_t enabled = end.enabled - start.enabled, running = end.running - start.running;
+        return running > 0 && running < enabled ? static_cast<uint64_t>(static_cast<double>(value) * enabled / running) : value;
     }
-};
 
-// Utility function to split strings based on a delimiter
-vector<string> split(const string& s, char delimiter) {
-    vector<string> tokens;
-    string token;
-    istringstream tokenStream(s);
-    while (getline(tokenStream, token, delimiter)) {
-        tokens.push_back(token);
+    bool available(int counter) const {
+        return fds[counter] >= 0;
     }
-    return tokens;
+
+    int error(int counter) const {
+        return errors[counter];
+    }
+
+private:
+    int fds[PERF_COUNTER_COUNT];
+    int errors[PERF_COUNTER_COUNT];
+    int leader;
+    int members[PERF_COUNTER_COUNT]; // Counter of each group member, in join order
+    int memberCount;
+};
+
+PerfCounters& threadPerfCounters() {
+    thread_local PerfCounters counters;
+    return counters;
 }
+#endif
 
-// Function to load data from a file into the system
-void loadDataFromFile(const string& filename, vector<Item*>& items) {
-    ifstream file(filename);  // Open the file for reading
-    string line, type, title, description, deadline, tags, password, interval;
-    int priority;
-    double progress;
+// Counter totals of one instrumented operation
+struct OperationCounters {
+    atomic<uint64_t> runs { 0 };
+    atomic<uint64_t> totals[PERF_COUNTER_COUNT] = {};
+};
 
-    // Read each line from the file
-    while (getline(file, line)) {
-        stringstream ss(line);  // Use stringstream for parsing the line
-        getline(ss, type, ',');  // Get the type of the item
-
-        if (type == "Task" || type == "RecurringTask" || type == "OneTimeTask") {
-            getline(ss, title, ',');
-            getline(ss, description, ',');
-            getline(ss, deadline, ',');
-            ss >> priority;
-            ss.ignore(1, ','); // Ignore the comma after reading priority
-            if (type == "RecurringTask") {
-                getline(ss, interval); // Read the interval
-                items.push_back(new RecurringTask(title, description, deadline, priority, interval));
-            }
-            else if (type == "OneTimeTask") {
-                items.push_back(new OneTimeTask(title, description, deadline, priority));
-            }
-            else {
-                items.push_back(new Task(title, description, deadline, priority));
-            }
+class PerfStats {
+public:
+    OperationCounters& operation(const string& name) {
+        UnattributedAllocations unattributed;
+        lock_guard<mutex> lock(statsMutex);
+        unique_ptr<OperationCounters>& slot = operations[name];
+        if (!slot) {
+            slot.reset(new OperationCounters());
         }
-        else if (type == "Note" || type == "ProtectedNote" || type == "PublicNote") {
-            getline(ss, title, ',');
-            getline(ss, description, ',');
-            getline(ss, tags, ',');
-            if (type == "ProtectedNote") {
-                getline(ss, password); // Read the password
-                vector<string> tagList = split(tags, ',');
-                items.push_back(new ProtectedNote(title, description, tagList, password));
-            }
-            else if (type == "PublicNote") {
-                vector<string> tagList = split(tags, ',');
-                items.push_back(new PublicNote(title, description, tagList));
-            }
-            else {
-                vector<string> tagList = split(tags, ',');
-                items.push_back(new Note(title, description, tagList));
+        return *slot;
+    }
+
+    void display() const {
+#if GTN_PERF_COUNTERS
+        static const char* const names[PERF_COUNTER_COUNT] = { "cycles", "instructions", "LLC misses", "branch misses", "task clock", "page faults" };
+        const PerfCounters& counters = threadPerfCounters();
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            if (!counters.available(c)) {
+                cout << "  " << names[c] << " unavailable: " << strerror(counters.error(c))
+                    << (counters.error(c) == ENOENT ? " (no hardware counters exposed, common in VMs and containers)" : "")
+                    << (counters.error(c) == EACCES || counters.error(c) == EPERM ? " (see /proc/sys/kernel/perf_event_paranoid)" : "") << "\n";
             }
         }
-        else if (type == "Goal" || type == "QuantifiableGoal" || type == "NonQuantifiableGoal") {
-            getline(ss, title, ',');
-            getline(ss, description, ',');
-            ss >> progress;
-            ss.ignore(); // Skip newline at the end
-            if (type == "QuantifiableGoal") {
-                items.push_back(new QuantifiableGoal(title, description, progress));
-            }
-            else if (type == "NonQuantifiableGoal") {
-                items.push_back(new NonQuantifiableGoal(title, description, progress));
+        lock_guard<mutex> lock(statsMutex);
+        cout << left << setw(32) << "Operation" << right << setw(8) << "Runs" << setw(14) << "Cycles/run" << setw(7) << "IPC" << setw(13) << "LLC miss/run"
+            << setw(14) << "Br miss/run" << setw(13) << "CPU/run" << setw(12) << "Faults/run" << "\n";
+        for (const auto& entry : operations) {
+            const OperationCounters& operation = *entry.second;
+            uint64_t runs = operation.runs.load();
+            if (runs == 0) {
+                continue;
             }
-            else {
-                items.push_back(new Goal(title, description, progress));
+            auto perRun = [&](int c) -> string {
+                if (!counters.available(c)) {
+                    return "n/a";
+                }
+                ostringstream out;
+                out << fixed << setprecision(0) << static_cast<double>(operation.totals[c].load()) / runs;
+                return out.str();
+            };
+            string ipc = "n/a";
+            if (counters.available(PERF_CYCLES) && counters.available(PERF_INSTRUCTIONS) && operation.totals[PERF_CYCLES].load() > 0) {
+                ostringstream out;
+                out << fixed << setprecision(2) << static_cast<double>(operation.totals[PERF_INSTRUCTIONS].load()) / operation.totals[PERF_CYCLES].load();
+                ipc = out.str();
             }
+            string cpu = counters.available(PERF_TASK_CLOCK) ? formatLatency(operation.totals[PERF_TASK_CLOCK].load() / runs) : "n/a";
+            cout << left << setw(32) << entry.first << right << setw(8) << runs << setw(14) << perRun(PERF_CYCLES) << setw(7) << ipc
+                << setw(13) << perRun(PERF_LLC_MISSES) << setw(14) << perRun(PERF_BRANCH_MISSES) << setw(13) << cpu << setw(12) << perRun(PERF_PAGE_FAULTS) << "\n";
         }
+        cout << left;
+#else
+        cout << "Hardware performance counters are not available in this build (Linux only, GTN_PERF_COUNTERS)." << endl;
+#endif
     }
 
-    file.close();  // Close the file after reading
+private:
+    mutable mutex statsMutex;
+    map<string, unique_ptr<OperationCounters>> operations;
+};
+
+PerfStats& perfStats() {
+    static PerfStats stats;
+    return stats;
 }
 
+// Adds the counter deltas of the rest of the scope to the operation while profiling is on
+class PerfScope {
+public:
+    PerfScope(OperationCounters& operation) : operation(operation), active(perfProfiling.load(memory_order_relaxed)) {
+#if GTN_PERF_COUNTERS
+        if (active) {
+            threadPerfCounters().read(start);
+        }
+#endif
+    }
 
+    ~PerfScope() {
+#if GTN_PERF_COUNTERS
+        if (active) {
+            PerfReading end;
+            threadPerfCounters().read(end);
+            operation.runs.fetch_add(1, memory_order_relaxed);
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                operation.totals[c].fetch_add(PerfCounters::delta(start, end, c), memory_order_relaxed);
+            }
+        }
+#endif
+    }
 
-// Function to merge two halves of a vector sorted by task priority
-void merge(vector<Task*>& tasks, int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-   
-    // Create temp arrays
-    vector<Task*> L(n1), R(n2);
+private:
+    OperationCounters& operation;
+    bool active;
+    PerfReading start;
+};
 
-    // Copy data to temp arrays L[] and R[]
-    for (int i = 0; i < n1; i++)
-        L[i] = tasks[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = tasks[mid + 1 + j];
+// Records the time from construction to destruction
+class LatencyTimer {
+public:
+    LatencyTimer(LatencyHistogram& histogram) : histogram(histogram), start(chrono::steady_clock::now()) {}
 
-    // Merge the temp arrays back into tasks[left..right]
-    int i = 0; // Initial index of first subarray
-    int j = 0; // Initial index of second subarray
-    int k = left; // Initial index of merged subarray
-    while (i < n1 && j < n2) {
+    ~LatencyTimer() {
+        histogram.record(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()));
+    }
+
+private:
+    LatencyHistogram& histogram;
+    chrono::steady_clock::time_point start;
+};
+
+// Execution tracing: TRACE_SPAN("name") records the enclosing scope as a complete event in a ring
+// buffer owned by the calling thread. Only the owner writes its buffer, so recording takes no lock;
+// writeChromeTrace() copies every buffer into Chrome trace JSON, which chrome://tracing and
+// Perfetto (ui.perfetto.dev) display with one track per thread.
+struct TraceSlot {
+    atomic<const char*> name { nullptr };
+    atomic<uint64_t> start { 0 };
+    atomic<uint64_t> duration { 0 };
+};
+
+struct TraceEvent {
+    const char* name;
+    uint64_t start, duration; // Nanoseconds since traceNow() was first called
+};
+
+class TraceBuffer {
+public:
+    static const size_t CAPACITY = 1 << 14; // Most recent events kept per thread
+
+    TraceBuffer(unsigned threadId) : threadId(threadId), retired(false), written(0) {}
+
+    void record(const char* name, uint64_t start, uint64_t duration) {
+        uint64_t index = written.load(memory_order_relaxed);
+        TraceSlot& slot = slots[index % CAPACITY];
+        slot.name.store(name, memory_order_relaxed);
+        slot.start.store(start, memory_order_relaxed);
+        slot.duration.store(duration, memory_order_relaxed);
+        written.store(index + 1, memory_order_release);
+    }
+
+    // Copies the events still in the buffer. Slots the owner overwrote during the copy are dropped,
+    // and so is slot written % CAPACITY: the owner may be halfway through writing it.
+    void copyEvents(vector<TraceEvent>& out) const {
+        uint64_t end = written.load(memory_order_acquire);
+        uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+        vector<TraceEvent> copied;
+        for (uint64_t i = begin; i < end; i++) {
+            const TraceSlot& slot = slots[i % CAPACITY];
+            copied.push_back({ slot.name.load(memory_order_relaxed), slot.start.load(memory_order_relaxed), slot.duration.load(memory_order_relaxed) });
+        }
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t now = written.load(memory_order_relaxed);
+        uint64_t firstIntact = now + 1 > CAPACITY ? now + 1 - CAPACITY : 0;
+        for (uint64_t i = max(begin, firstIntact); i < end; i++) {
+            out.push_back(copied[i - begin]);
+        }
+    }
+
+    // Reuses the buffer of an exited thread for a new one
+    void reset(unsigned newThreadId) {
+        threadId = newThreadId;
+        threadName.clear();
+        written.store(0, memory_order_relaxed);
+        retired.store(false, memory_order_relaxed);
+    }
+
+    unsigned threadId;
+    string threadName; // Guarded by the registry mutex
+    atomic<bool> retired; // The owning thread has exited
+
+private:
+    array<TraceSlot, CAPACITY> slots;
+    atomic<uint64_t> written;
+};
+
+// All trace buffers. Buffers of exited threads stay exportable until the registry is full, then
+// the oldest one is recycled, so short-lived pipeline workers do not grow memory without bound.
+class TraceRegistry {
+public:
+    static const size_t MAX_BUFFERS = 64;
+
+    TraceBuffer* acquire() {
+        UnattributedAllocations unattributed;
+        lock_guard<mutex> lock(registryMutex);
+        unsigned threadId = ++lastThreadId;
+        if (buffers.size() >= MAX_BUFFERS) {
+            for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+                if ((*it)->retired.load()) {
+                    unique_ptr<TraceBuffer> recycled = move(*it);
+                    buffers.erase(it);
+                    recycled->reset(threadId);
+                    buffers.push_back(move(recycled));
+                    return buffers.back().get();
+                }
+            }
+        }
+        buffers.emplace_back(new TraceBuffer(threadId));
+        return buffers.back().get();
+    }
+
+    void setThreadName(TraceBuffer* buffer, const string& name) {
+        lock_guard<mutex> lock(registryMutex);
+        buffer->threadName = name;
+    }
+
+    // Writes every recorded event in Chrome trace JSON ("X" complete events, times in microseconds)
+    bool writeChromeTrace(const string& filename) const {
+        ofstream out(filename);
+        lock_guard<mutex> lock(registryMutex);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GTN Manager\"}}";
+        vector<TraceEvent> events;
+        for (const auto& buffer : buffers) {
+            string name = buffer->threadName.empty() ? "thread " + to_string(buffer->threadId) : buffer->threadName;
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"" << name << "\"}}";
+            events.clear();
+            buffer->copyEvents(events);
+            for (const TraceEvent& event : events) {
+                out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"gtn\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << fixed << setprecision(3)
+                    << ",\"ts\":" << event.start / 1e3 << ",\"dur\":" << event.duration / 1e3 << "}";
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    mutable mutex registryMutex;
+    vector<unique_ptr<TraceBuffer>> buffers;
+    unsigned lastThreadId = 0;
+};
+
+TraceRegistry& traceRegistry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+// Nanoseconds since the first call; the first call happens early in main()
+uint64_t traceNow() {
+    static const chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count());
+}
+
+// The calling thread's buffer, created on its first span and retired when the thread exits
+TraceBuffer* currentTraceBuffer() {
+    struct Owner {
+        TraceBuffer* buffer = traceRegistry().acquire();
+        ~Owner() {
+            buffer->retired.store(true);
+        }
+    };
+    thread_local Owner owner;
+    return owner.buffer;
+}
+
+// Names the calling thread's track in exported traces
+void traceThreadName(const string& name) {
+    traceRegistry().setThreadName(currentTraceBuffer(), name);
+}
+
+// Records the time from construction to destruction as one span; name must be a string literal
+class TraceSpan {
+public:
+    TraceSpan(const char* name) : name(name), start(traceNow()) {}
+
+    ~TraceSpan() {
+        currentTraceBuffer()->record(name, start, traceNow() - start);
+    }
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+// Build with -DGTN_TRACING=0 to compile the spans out
+#ifndef GTN_TRACING
+#define GTN_TRACING 1
+#endif
+
+// TIME_OPERATION("name") times the rest of the enclosing scope, records it as a trace span and
+// attributes its allocations and performance counters to the operation. The histogram is looked
+// up once per call site.
+// Build with -DGTN_LATENCY_STATS=0 to compile the timers out.
+#ifndef GTN_LATENCY_STATS
+#define GTN_LATENCY_STATS 1
+#endif
+#define LATENCY_CONCAT_(a, b) a##b
+#define LATENCY_CONCAT(a, b) LATENCY_CONCAT_(a, b)
+#if GTN_TRACING
+#define TRACE_SPAN(name) TraceSpan LATENCY_CONCAT(traceSpan, __LINE__)(name)
+#else
+#define TRACE_SPAN(name) ((void)0)
+#endif
+#if GTN_ALLOCATION_TRACKING
+#define TRACK_ALLOCATIONS(name) \
+    static OperationAllocations& LATENCY_CONCAT(operationAllocations, __LINE__) = allocationStats().operation(name); \
+    AllocationScope LATENCY_CONCAT(allocationScope, __LINE__)(LATENCY_CONCAT(operationAllocations, __LINE__))
+#else
+#define TRACK_ALLOCATIONS(name) ((void)0)
+#endif
+#if GTN_PERF_COUNTERS
+#define COUNT_PERF_EVENTS(name) \
+    static OperationCounters& LATENCY_CONCAT(operationCounters, __LINE__) = perfStats().operation(name); \
+    PerfScope LATENCY_CONCAT(perfScope, __LINE__)(LATENCY_CONCAT(operationCounters, __LINE__))
+#else
+#define COUNT_PERF_EVENTS(name) ((void)0)
+#endif
+#if GTN_LATENCY_STATS
+#define TIME_OPERATION(name) \
+    TRACE_SPAN(name); \
+    TRACK_ALLOCATIONS(name); \
+    COUNT_PERF_EVENTS(name); \
+    static LatencyHistogram& LATENCY_CONCAT(latencyHistogram, __LINE__) = latencyStats().histogram(name); \
+    LatencyTimer LATENCY_CONCAT(latencyTimer, __LINE__)(LATENCY_CONCAT(latencyHistogram, __LINE__))
+#else
+#define TIME_OPERATION(name) \
+    TRACE_SPAN(name); \
+    TRACK_ALLOCATIONS(name); \
+    COUNT_PERF_EVENTS(name)
+#endif
+
+// Structured form of a RecurringTask interval such as "Daily", "Weekly", "Monthly" or "Every 3 days".
+// The task's deadline is the first occurrence. Month-based rules keep the day of month and use the
+// last day of shorter months (Jan 31 -> Feb 28 -> Mar 31). A task without a valid deadline has no
+// anchor and recurs from whichever date it is asked about.
+struct RecurrenceRule {
+    enum Unit { NONE, DAYS, MONTHS };
+
+    Unit unit = NONE;
+    int step = 0;           // Days or months between occurrences
+    bool anchored = false;
+    int anchor = 0;         // First occurrence, in days since 1970-01-01
+    int anchorMonth = 0;    // First occurrence as year * 12 + month - 1 (month rules)
+    unsigned anchorDay = 0; // Day of month of the first occurrence (month rules)
+
+    // Parses an interval; the rule is invalid (valid() is false) if the text is not understood
+    static RecurrenceRule parse(const string& interval, const string& firstDate) {
+        RecurrenceRule rule;
+        string text;
+        for (char c : interval) {
+            text += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+        istringstream words(text);
+        string word;
+        words >> word;
+        int count = 1;
+        if (word == "every") {
+            string amount;
+            words >> amount;
+            if (!amount.empty() && isdigit(static_cast<unsigned char>(amount[0]))) {
+                count = atoi(amount.c_str());
+                words >> word;
+            }
+            else {
+                word = amount;
+            }
+            if (!word.empty() && word.back() == 's') {
+                word.pop_back();
+            }
+        }
+        if (count <= 0 || count > 10000) {
+            return rule;
+        }
+        if (word == "daily" || word == "day") rule.setStep(DAYS, count);
+        else if (word == "weekly" || word == "week") rule.setStep(DAYS, 7 * count);
+        else if (word == "biweekly" || word == "fortnightly") rule.setStep(DAYS, 14);
+        else if (word == "monthly" || word == "month") rule.setStep(MONTHS, count);
+        else if (word == "quarterly") rule.setStep(MONTHS, 3);
+        else if (word == "yearly" || word == "annually" || word == "year") rule.setStep(MONTHS, 12 * count);
+        if (rule.valid() && parseDate(firstDate, rule.anchor)) {
+            rule.setAnchor(rule.anchor);
+        }
+        return rule;
+    }
+
+    bool valid() const {
+        return unit != NONE;
+    }
+
+    // Copy of the rule whose first occurrence is the given day
+    RecurrenceRule anchoredAt(int day) const {
+        RecurrenceRule rule = *this;
+        rule.setAnchor(day);
+        return rule;
+    }
+
+    // Occurrence number k (0 is the first) of an anchored rule
+    int occurrence(long long k) const {
+        if (unit == DAYS) {
+            return static_cast<int>(anchor + k * step);
+        }
+        long long monthIndex = anchorMonth + k * step;
+        int year = static_cast<int>(monthIndex / 12);
+        unsigned month = static_cast<unsigned>(monthIndex % 12) + 1;
+        return daysFromCivil(year, month, min(anchorDay, daysInMonth(year, month)));
+    }
+
+    // First occurrence strictly after the given day, computed directly instead of stepping from the start
+    int nextAfter(int day) const {
+        if (!anchored) {
+            return anchoredAt(day).occurrence(1);
+        }
+        if (day < anchor) {
+            return anchor;
+        }
+        if (unit == DAYS) {
+            return occurrence((day - anchor) / step + 1);
+        }
+        int year;
+        unsigned month, dayOfMonth;
+        civilFromDays(day, year, month, dayOfMonth);
+        long long k = (year * 12LL + month - 1 - anchorMonth) / step; // Last occurrence in or before day's month
+        return occurrence(occurrence(k) > day ? k : k + 1);
+    }
+
+private:
+    void setStep(Unit newUnit, int newStep) {
+        unit = newUnit;
+        step = newStep;
+    }
+
+    void setAnchor(int day) {
+        int year;
+        unsigned month;
+        civilFromDays(day, year, month, anchorDay);
+        anchored = true;
+        anchor = day;
+        anchorMonth = year * 12 + static_cast<int>(month) - 1;
+    }
+};
+
+// Lazily yields the occurrences of a rule inside [from, to], one per next() call, without storing them
+class OccurrenceGenerator {
+public:
+    OccurrenceGenerator(const RecurrenceRule& rule, int from, int to) :
+        rule(rule.anchored || !rule.valid() ? rule : rule.anchoredAt(from)), to(to) {
+        current = this->rule.valid() ? this->rule.nextAfter(from - 1) : to + 1;
+    }
+
+    bool next(int& day) {
+        if (current > to) {
+            return false;
+        }
+        day = current;
+        current = rule.nextAfter(current);
+        return true;
+    }
+
+private:
+    RecurrenceRule rule;
+    int to;
+    int current;
+};
+
+// SHA-256 (FIPS 180-4)
+class Sha256 {
+public:
+    Sha256() : length(0), buffered(0) {
+        static const uint32_t initial[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+        memcpy(state, initial, sizeof(state));
+    }
+
+    void update(const uint8_t* data, size_t size) {
+        length += size;
+        while (size > 0) {
+            size_t take = min(size, sizeof(buffer) - buffered);
+            memcpy(buffer + buffered, data, take);
+            buffered += take;
+            data += take;
+            size -= take;
+            if (buffered == sizeof(buffer)) {
+                compress(buffer);
+                buffered = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t digest[32]) {
+        uint64_t bits = length * 8;
+        uint8_t padding[72] = { 0x80 };
+        size_t padLength = (buffered < 56 ? 56 : 120) - buffered;
+        for (int i = 0; i < 8; i++) {
+            padding[padLength + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        }
+        update(padding, padLength + 8);
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 4; j++) {
+                digest[4 * i + j] = static_cast<uint8_t>(state[i] >> (24 - 8 * j));
+            }
+        }
+    }
+
+private:
+    static uint32_t rotr(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+    void compress(const uint8_t block[64]) {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = static_cast<uint32_t>(block[4 * i]) << 24 | static_cast<uint32_t>(block[4 * i + 1]) << 16 | static_cast<uint32_t>(block[4 * i + 2]) << 8 | block[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    uint32_t state[8];
+    uint8_t buffer[64];
+    uint64_t length;
+    size_t buffered;
+};
+
+// HMAC-SHA256 (RFC 2104). The key is absorbed once, so computing many MACs with one key
+// (as PBKDF2 does) costs two compressions per short message.
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t* key, size_t keySize) {
+        uint8_t block[64] = {};
+        if (keySize > sizeof(block)) {
+            Sha256 hash;
+            hash.update(key, keySize);
+            hash.finish(block);
+        }
+        else {
+            memcpy(block, key, keySize);
+        }
+        uint8_t pad[64];
+        for (int i = 0; i < 64; i++) {
+            pad[i] = block[i] ^ 0x36;
+        }
+        inner.update(pad, sizeof(pad));
+        for (int i = 0; i < 64; i++) {
+            pad[i] = block[i] ^ 0x5c;
+        }
+        outer.update(pad, sizeof(pad));
+    }
+
+    void compute(const uint8_t* data, size_t size, uint8_t mac[32]) const {
+        Sha256 hash = inner;
+        hash.update(data, size);
+        hash.finish(mac);
+        hash = outer;
+        hash.update(mac, 32);
+        hash.finish(mac);
+    }
+
+private:
+    Sha256 inner, outer;
+};
+
+// PBKDF2-HMAC-SHA256 (RFC 8018) producing one 32-byte block
+void pbkdf2Sha256(const string& password, const string& salt, int iterations, uint8_t key[32]) {
+    HmacSha256 prf(reinterpret_cast<const uint8_t*>(password.data()), password.size());
+    string first = salt + string("\0\0\0\1", 4); // Block index 1
+    uint8_t u[32];
+    prf.compute(reinterpret_cast<const uint8_t*>(first.data()), first.size(), u);
+    memcpy(key, u, 32);
+    for (int i = 1; i < iterations; i++) {
+        prf.compute(u, 32, u);
+        for (int j = 0; j < 32; j++) {
+            key[j] ^= u[j];
+        }
+    }
+}
+
+// ChaCha20 (RFC 8439) with a zero nonce: XORs the keystream into the data. Every key here is used
+// for a single message, so the nonce never needs to vary.
+void chacha20Xor(const uint8_t key[32], uint8_t* data, size_t size) {
+    uint32_t input[16] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    for (int i = 0; i < 8; i++) {
+        input[4 + i] = static_cast<uint32_t>(key[4 * i]) | static_cast<uint32_t>(key[4 * i + 1]) << 8 | static_cast<uint32_t>(key[4 * i + 2]) << 16 | static_cast<uint32_t>(key[4 * i + 3]) << 24;
+    }
+    auto quarterRound = [](uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+        a += b; d ^= a; d = (d << 16) | (d >> 16);
+        c += d; b ^= c; b = (b << 12) | (b >> 20);
+        a += b; d ^= a; d = (d << 8) | (d >> 24);
+        c += d; b ^= c; b = (b << 7) | (b >> 25);
+    };
+    for (size_t offset = 0; offset < size; offset += 64) {
+        input[12] = static_cast<uint32_t>(offset / 64); // Block counter; words 13-15 are the zero nonce
+        uint32_t x[16];
+        memcpy(x, input, sizeof(x));
+        for (int round = 0; round < 10; round++) {
+            quarterRound(x[0], x[4], x[8], x[12]);
+            quarterRound(x[1], x[5], x[9], x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8], x[13]);
+            quarterRound(x[3], x[4], x[9], x[14]);
+        }
+        for (size_t i = 0; i < 64 && offset + i < size; i++) {
+            uint32_t word = x[i / 4] + input[i / 4];
+            data[offset + i] ^= static_cast<uint8_t>(word >> (8 * (i % 4)));
+        }
+    }
+}
+
+// Sealing of protected note bodies. Each note gets a 16-byte salt from the OS random source, and its
+// key is PBKDF2 over the password with that salt, so a precomputed table cannot attack all notes of
+// all data files at once. The PBKDF2 result is cached for the session per password and salt, so
+// opening the same note again does not repeat it. Encryption and MAC keys are derived from the note
+// key with HMAC; the body is encrypted with ChaCha20 and authenticated with HMAC-SHA256
+// (encrypt-then-MAC), so a wrong password is detected by the MAC check.
+// Sealed form: "ENC1:" + hex(salt | MAC | ciphertext).
+const int NOTE_KEY_ITERATIONS = 100000;
+const char* const SEALED_NOTE_PREFIX = "ENC1:";
+
+// Password-derived key of the note with the given salt, from the session cache when the note was
+// opened or sealed before. The cache is keyed by an HMAC of the password under a random per-session
+// key and the salt, so it holds no password or fast password hash.
+void noteKey(const string& password, const uint8_t salt[16], uint8_t key[32]) {
+    static mutex cacheMutex;
+    static unordered_map<string, array<uint8_t, 32>> cache;
+    static const HmacSha256 cacheKey = []() {
+        random_device random;
+        uint32_t seed[8];
+        for (uint32_t& word : seed) {
+            word = random();
+        }
+        return HmacSha256(reinterpret_cast<const uint8_t*>(seed), sizeof(seed));
+    }();
+    uint8_t id[32];
+    cacheKey.compute(reinterpret_cast<const uint8_t*>(password.data()), password.size(), id);
+    string cacheId(reinterpret_cast<const char*>(id), sizeof(id));
+    cacheId.append(reinterpret_cast<const char*>(salt), 16);
+    {
+        lock_guard<mutex> lock(cacheMutex);
+        auto found = cache.find(cacheId);
+        if (found != cache.end()) {
+            memcpy(key, found->second.data(), 32);
+            return;
+        }
+    }
+    pbkdf2Sha256(password, string(reinterpret_cast<const char*>(salt), 16), NOTE_KEY_ITERATIONS, key);
+    lock_guard<mutex> lock(cacheMutex);
+    memcpy(cache[cacheId].data(), key, 32);
+}
+
+// Encryption and MAC keys of the note with the given salt
+void noteKeys(const string& password, const uint8_t salt[16], uint8_t encryptionKey[32], uint8_t macKey[32]) {
+    uint8_t key[32];
+    noteKey(password, salt, key);
+    HmacSha256 derive(key, sizeof(key));
+    derive.compute(reinterpret_cast<const uint8_t*>("encrypt"), 7, encryptionKey);
+    derive.compute(reinterpret_cast<const uint8_t*>("authenticate"), 12, macKey);
+}
+
+bool isSealedNoteBody(const string& text) {
+    return text.compare(0, strlen(SEALED_NOTE_PREFIX), SEALED_NOTE_PREFIX) == 0;
+}
+
+// Encrypts a note body under a key derived from the password
+string sealNoteBody(const string& body, const string& password) {
+    // All 128 salt bits come from the OS random source: the salt makes the note key, and with it
+    // the ChaCha20 keystream, unique
+    vector<uint8_t> sealed(48 + body.size()); // Salt, MAC, ciphertext
+#ifdef __linux__
+    if (getrandom(sealed.data(), 16, 0) != 16)
+#endif
+    {
+        static thread_local random_device saltSource; // rand_s on Windows
+        for (int i = 0; i < 16; i += 4) {
+            uint32_t random = saltSource();
+            memcpy(&sealed[i], &random, 4);
+        }
+    }
+    uint8_t encryptionKey[32], macKey[32];
+    noteKeys(password, sealed.data(), encryptionKey, macKey);
+    memcpy(&sealed[48], body.data(), body.size());
+    chacha20Xor(encryptionKey, &sealed[48], body.size());
+    vector<uint8_t> authenticated(sealed.begin(), sealed.begin() + 16);
+    authenticated.insert(authenticated.end(), sealed.begin() + 48, sealed.end());
+    HmacSha256(macKey, sizeof(macKey)).compute(authenticated.data(), authenticated.size(), &sealed[16]);
+
+    static const char digits[] = "0123456789abcdef";
+    string text = SEALED_NOTE_PREFIX;
+    for (uint8_t byte : sealed) {
+        text += digits[byte >> 4];
+        text += digits[byte & 15];
+    }
+    return text;
+}
+
+// Decrypts a sealed body; false if the password is wrong or the text was damaged
+bool openNoteBody(const string& text, const string& password, string& body) {
+    size_t prefixLength = strlen(SEALED_NOTE_PREFIX);
+    if (!isSealedNoteBody(text) || (text.size() - prefixLength) % 2 != 0 || text.size() - prefixLength < 96) {
+        return false;
+    }
+    vector<uint8_t> sealed((text.size() - prefixLength) / 2);
+    for (size_t i = 0; i < sealed.size(); i++) {
+        const char* pair = text.data() + prefixLength + 2 * i;
+        if (from_chars(pair, pair + 2, sealed[i], 16).ptr != pair + 2) {
+            return false;
+        }
+    }
+    uint8_t encryptionKey[32], macKey[32], mac[32];
+    noteKeys(password, sealed.data(), encryptionKey, macKey);
+    vector<uint8_t> authenticated(sealed.begin(), sealed.begin() + 16);
+    authenticated.insert(authenticated.end(), sealed.begin() + 48, sealed.end());
+    HmacSha256(macKey, sizeof(macKey)).compute(authenticated.data(), authenticated.size(), mac);
+    uint8_t difference = 0;
+    for (int i = 0; i < 32; i++) {
+        difference |= mac[i] ^ sealed[16 + i]; // Constant-time comparison
+    }
+    if (difference != 0) {
+        return false;
+    }
+    chacha20Xor(encryptionKey, &sealed[48], sealed.size() - 48);
+    body.assign(sealed.begin() + 48, sealed.end());
+    return true;
+}
+
+// Base class for all types of items managed by GTN Manager
+class Item {
+public:
+    size_t id; // Unique ID assigned by the ItemStore (0 until the item is stored)
+    string title;
+    string description;
+
+    // Constructor initializes title and description
+    Item(const string& title, const string& description) : id(0), title(title), description(description) {}
+
+    // Pure virtual functions to be implemented by derived classes
+    virtual void display() const = 0;
+    virtual string getDetails() const = 0;
+    virtual void appendRecord(string& out) const = 0; // Appends the item as one data.txt line (without the newline)
+
+    // Returns the item as one data.txt line
+    string getRecord() const {
+        string record;
+        appendRecord(record);
+        return record;
+    }
+  
+    // Virtual destructor for proper cleanup of derived classes
+    virtual ~Item() {} 
+};
+
+
+// Task class derived from Item for managing tasks
+class Task : public Item {
+public:
+    string deadline;
+    int priority;
+
+    // Constructor initializes Task attributes along with inherited attributes
+    Task(const string& title, const string& description, const string& deadline, int priority) :
+        Item(title, description), deadline(deadline), priority(priority) {}
+
+    // Displays task information
+    void display() const override {
+        cout << "Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << endl;
+    }
+
+    // Returns task details as a formatted string
+    string getDetails() const override {
+        return "Title: " + title + "\nDescription: " + description + "\nDeadline: " + deadline + "\nPriority: " + to_string(priority);
+    }
+
+    // Appends the task as a data.txt record
+    void appendRecord(string& out) const override {
+        out += "Task,";
+        appendRecordFields(out);
+    }
+
+protected:
+    // Fields shared by all task records: title,description,deadline,priority
+    void appendRecordFields(string& out) const {
+        appendRecordField(out, title);
+        out += ',';
+        appendRecordField(out, description);
+        out += ',';
+        appendRecordField(out, deadline);
+        out += ',';
+        appendRecordNumber(out, priority);
+    }
+};
+
+
+// Specialized Task class for recurring tasks
+class RecurringTask : public Task {
+public:
+    string recurrenceInterval;
+    RecurrenceRule recurrence; // Parsed from the interval and the deadline (first occurrence)
+
+    RecurringTask(const string& title, const string& description, const string& deadline, int priority, const string& interval) :
+        Task(title, description, deadline, priority), recurrenceInterval(interval), recurrence(RecurrenceRule::parse(interval, deadline)) {}
+
+    void display() const override {
+        cout << "Recurring Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << ", Interval: " << recurrenceInterval << endl;
+    }
+
+    string getDetails() const override {
+        return Task::getDetails() + "\nRecurrence Interval: " + recurrenceInterval;
+    }
+
+    void appendRecord(string& out) const override {
+        out += "RecurringTask,";
+        appendRecordFields(out);
+        out += ',';
+        appendRecordField(out, recurrenceInterval, "\r\n"); // Last field: commas are read back intact
+    }
+};
+
+
+// Specialized Task class for one-time tasks
+class OneTimeTask : public Task {
+public:
+    OneTimeTask(const string& title, const string& description, const string& deadline, int priority) :
+        Task(title, description, deadline, priority) {}
+
+    void display() const override {
+        cout << "One-Time Task: " << title << ", Deadline: " << deadline << ", Priority: " << priority << endl;
+    }
+
+    string getDetails() const override {
+        return Task::getDetails();
+    }
+
+    void appendRecord(string& out) const override {
+        out += "OneTimeTask,";
+        appendRecordFields(out);
+    }
+};
+
+
+// Note class derived from Item for managing notes
+class Note : public Item {
+public:
+    vector<string> tags;// Tags associated with the note
+
+    Note(const string& title, const string& description, const vector<string>& tags) :
+        Item(title, description), tags(tags) {}
+
+    // Display basic note information along with tags
+    void display() const override {
+        cout << "Note: " << title << " [Tags: ";
+        for (const auto& tag : tags) {
+            cout << tag << " ";
+        }
+        cout << "]" << endl;
+    }
+
+    // Returns detailed information about the note including all tags
+    string getDetails() const override {
+        string details = "Title: " + title + "\nDescription: " + description + "\nTags: ";
+        for (const auto& tag : tags) {
+            details += tag + ", ";
+        }
+        // Remove trailing comma and space from tags list
+        details.pop_back(); // Remove the last comma
+        details.pop_back(); // Remove the last space
+        return details;
+    }
+
+    // Appends the note as a data.txt record
+    void appendRecord(string& out) const override {
+        out += "Note,";
+        appendRecordFields(out);
+    }
+
+protected:
+    // Fields shared by all note records: title,description,tags (tags joined by ';')
+    void appendRecordFields(string& out) const {
+        appendRecordField(out, title);
+        out += ',';
+        appendRecordField(out, description);
+        out += ',';
+        for (size_t i = 0; i < tags.size(); i++) {
+            if (i) {
+                out += ';';
+            }
+            appendRecordField(out, tags[i], ",;\r\n");
+        }
+    }
+};
+
+// ProtectedNote class for notes that require a password to access
+// The description holds the body sealed with a key derived from the password (see sealNoteBody);
+// neither the password nor the plain body is kept in memory or written to data.txt.
+class ProtectedNote : public Note {
+public:
+    // Seals a plain body right away. A body that is already sealed (from data.txt) is taken as it is,
+    // without any key derivation, so loading costs the same as for other notes.
+    ProtectedNote(const string& title, const string& description, const vector<string>& tags, const string& password) :
+        Note(title, password.empty() && isSealedNoteBody(description) ? description : sealNoteBody(description, password), tags) {}
+
+    void display() const override {
+        cout << "Protected Note: " << title << " [Protected]" << endl;
+    }
+
+    string getDetails() const override {
+        return Note(title, "[encrypted]", tags).getDetails() + "\nPassword Protected";
+    }
+
+    // Decrypts the body and returns the full details; false if the password is wrong
+    bool unlock(const string& password, string& details) const {
+        string body;
+        if (!openNoteBody(description, password, body)) {
+            return false;
+        }
+        details = Note(title, body, tags).getDetails() + "\nPassword Protected";
+        return true;
+    }
+
+    void appendRecord(string& out) const override {
+        out += "ProtectedNote,";
+        appendRecordFields(out);
+        out += ','; // The password field stays empty: the sealed description replaces it
+    }
+};
+
+// PublicNote class for notes that are publicly accessible
+class PublicNote : public Note {
+public:
+    PublicNote(const string& title, const string& description, const vector<string>& tags) :
+        Note(title, description, tags) {}
+
+    // Display public note information
+    void display() const override {
+        cout << "Public Note: " << title << " [Tags: ";
+        for (const auto& tag : tags) {
+            cout << tag << " ";
+        }
+        cout << "]" << endl;
+    }
+
+    // Returns details of the public note
+    string getDetails() const override {
+        return Note::getDetails();
+    }
+
+    void appendRecord(string& out) const override {
+        out += "PublicNote,";
+        appendRecordFields(out);
+    }
+};
+
+
+// Goal base class derived from Item, for managing goals with a progress attribute
+class Goal : public Item {
+protected:
+    double progress;// Progress percentage of the goal
+
+public:
+    // Sub-goal hierarchy, maintained by GoalTree
+    Goal* parentGoal = nullptr;
+    vector<Goal*> subGoals;
+    double weight = 1;                // Weight in the parent's roll-up
+    double childWeight = 0;           // Sum of the weights of quantifiable sub-goals
+    double childWeightedProgress = 0; // Sum of weight * rolled-up progress of quantifiable sub-goals
+
+    Goal(const string& title, const string& description, double progress) : Item(title, description), progress(progress) {}
+
+    // Display goal information including progress percentage
+    virtual void display() const override {
+        cout << "Goal: " << title << ", Progress: " << fixed << setprecision(0) << progress * 100 << "%" << endl;
+    }
+    // Returns details of the goal including formatted progress
+    virtual string getDetails() const override {
+        return "Title: " + title + "\nDescription: " + description + "\nProgress: " + to_string(static_cast<int>(progress * 100)) + "%";
+    }
+    // Returns the current progress of the goal
+    virtual double getProgress() const {
+        return progress;
+    }
+    // Sets the progress (0 to 1); use through ItemStore::update for stored goals
+    void setProgress(double newProgress) {
+        progress = newProgress;
+    }
+    // Weighted progress of the quantifiable sub-goals, or the goal's own progress if it has none
+    double rolledUpProgress() const {
+        return childWeight > 0 ? childWeightedProgress / childWeight : getProgress();
+    }
+    // Appends the goal as a data.txt record
+    virtual void appendRecord(string& out) const override {
+        out += "Goal,";
+        appendRecordFields(out);
+    }
+
+protected:
+    // Fields shared by all goal records: title,description,progress
+    void appendRecordFields(string& out) const {
+        appendRecordField(out, title);
+        out += ',';
+        appendRecordField(out, description);
+        out += ',';
+        appendRecordNumber(out, progress);
+    }
+};
+
+// QuantifiableGoal class derived from Goal for goals that have quantifiable progress
+class QuantifiableGoal : public Goal {
+public:
+    QuantifiableGoal(const string& title, const string& description, double progress) : Goal(title, description, progress) {}
+
+    void display() const override {
+        cout << "Quantifiable Goal: " << title << ", Progress: " << fixed << setprecision(0) << progress * 100 << "%" << endl;
+    }
+
+    string getDetails() const override {
+        return Goal::getDetails();
+    }
+
+    void appendRecord(string& out) const override {
+        out += "QuantifiableGoal,";
+        appendRecordFields(out);
+    }
+
+    double getProgress() const override {
+        return progress;
+    }
+};
+
+// NonQuantifiableGoal class for goals where progress is not quantified
+class NonQuantifiableGoal : public Goal {
+public:
+    NonQuantifiableGoal(const string& title, const string& description, double progress) : Goal(title, description, progress) {}
+
+    void display() const override {
+        cout << "Non-Quantifiable Goal: " << title << " - Progress not quantified." << endl;
+    }
+
+    string getDetails() const override {
+        return Goal::getDetails() + "\nNon-quantifiable progress";
+    }
+
+    void appendRecord(string& out) const override {
+        out += "NonQuantifiableGoal,";
+        appendRecordFields(out);
+    }
+
+    double getProgress() const override {
+        // Return a special value indicating non-quantifiability
+        return -1.0;
+    }
+};
+
+
+// Secondary index kept up to date by ItemStore.
+// Implementations synchronize internally because inserts can arrive from several threads.
+class ItemIndex {
+public:
+    virtual ~ItemIndex() {}
+
+    // Called after a single item was added to the store
+    virtual void onInsert(Item* item) = 0;
+
+    // Called once for a whole batch; override to bulk-build instead of inserting item by item
+    virtual void onInsertBatch(const vector<Item*>& items) {
+        for (Item* item : items) {
+            onInsert(item);
+        }
+    }
+
+    // Called before and after an item is changed in place through ItemStore::update
+    virtual void onBeforeUpdate(Item*) {}
+    virtual void onUpdate(Item*) {}
+};
+
+
+// Thread-safe owner of all items, sharded by item ID.
+// Each shard has its own reader-writer lock, so many readers (listings, sorts, searches)
+// can run at the same time as writers adding items to other shards.
+// Items are never moved or freed before clear(), so pointers handed out by snapshots stay valid.
+class ItemStore {
+public:
+    static const size_t SHARD_COUNT = 16;
+
+    ItemStore() : nextId(1), changes(0) {}
+    ItemStore(const ItemStore&) = delete;
+    ItemStore& operator=(const ItemStore&) = delete;
+
+    ~ItemStore() {
+        clear();
+    }
+
+    // Takes ownership of the item, assigns it a new ID and returns that ID
+    size_t add(Item* item) {
+        size_t id = nextId.fetch_add(1);
+        item->id = id;
+        Shard& shard = shards[id % SHARD_COUNT];
+        unique_lock<shared_mutex> lock(shard.mutex);
+        // Shards stay sorted by ID; a concurrent add with a higher ID may have got the lock first
+        auto position = shard.items.end();
+        while (position != shard.items.begin() && (*(position - 1))->id > id) {
+            --position;
+        }
+        shard.items.insert(position, item);
+        for (ItemIndex* index : indexes) {
+            index->onInsert(item);
+        }
+        changes++;
+        return id;
+    }
+
+    // Applies an in-place change to a stored item, then notifies the indexes and counts the modification
+    void update(Item* item, const function<void()>& change) {
+        unique_lock<shared_mutex> lock(shards[item->id % SHARD_COUNT].mutex);
+        for (ItemIndex* index : indexes) {
+            index->onBeforeUpdate(item);
+        }
+        change();
+        for (ItemIndex* index : indexes) {
+            index->onUpdate(item);
+        }
+        changes++;
+    }
+
+    // Appends the item's data.txt record under its shard's shared lock, so saves running beside the
+    // interactive thread (checkpoints) never read an item while update() is changing it
+    void appendRecord(const Item* item, string& out) const {
+        shared_lock<shared_mutex> lock(shards[item->id % SHARD_COUNT].mutex);
+        item->appendRecord(out);
+    }
+
+    // Takes ownership of many items at once and gives them consecutive IDs; returns the first ID.
+    // All shards are locked for the duration, so readers see either none or all of the batch.
+    // Storage is reserved before anything is modified, so running out of memory leaves the store unchanged.
+    // Indexes get one onInsertBatch call instead of one onInsert per item.
+    size_t addBatch(const vector<Item*>& items) {
+        vector<unique_lock<shared_mutex>> locks;
+        locks.reserve(SHARD_COUNT);
+        for (Shard& shard : shards) {
+            locks.emplace_back(shard.mutex); // Always locked in shard order to avoid deadlocks
+        }
+
+        // Consecutive IDs spread evenly, so no shard receives more than this many of the batch
+        size_t perShard = items.size() / SHARD_COUNT + 1;
+        for (Shard& shard : shards) {
+            size_t needed = shard.items.size() + perShard;
+            if (needed > shard.items.capacity()) {
+                shard.items.reserve(max(needed, shard.items.capacity() * 2)); // Keep growth geometric across many batches
+            }
+        }
+
+        size_t firstId = nextId.fetch_add(items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            items[i]->id = firstId + i;
+            shards[items[i]->id % SHARD_COUNT].items.push_back(items[i]);
+        }
+        for (ItemIndex* index : indexes) {
+            index->onInsertBatch(items);
+        }
+        changes += items.size();
+        return firstId;
+    }
+
+    // Returns the item with the given ID, or nullptr
+    Item* find(size_t id) const {
+        const Shard& shard = shards[id % SHARD_COUNT];
+        shared_lock<shared_mutex> lock(shard.mutex);
+        auto it = lower_bound(shard.items.begin(), shard.items.end(), id, [](const Item* item, size_t value) { return item->id < value; });
+        return it != shard.items.end() && (*it)->id == id ? *it : nullptr;
+    }
+
+    // Returns the items with IDs in [firstId, lastId] in ID order, in O(k log n)
+    vector<Item*> findRange(size_t firstId, size_t lastId) const {
+        vector<Item*> result;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> lock(shard.mutex);
+            auto it = lower_bound(shard.items.begin(), shard.items.end(), firstId, [](const Item* item, size_t value) { return item->id < value; });
+            for (; it != shard.items.end() && (*it)->id <= lastId; ++it) {
+                result.push_back(*it);
+            }
+        }
+        sort(result.begin(), result.end(), [](const Item* a, const Item* b) { return a->id < b->id; });
+        return result;
+    }
+
+    // Registers an index (not owned) and builds it from the items already stored
+    void attachIndex(ItemIndex* index) {
+        vector<unique_lock<shared_mutex>> locks;
+        for (Shard& shard : shards) {
+            locks.emplace_back(shard.mutex);
+        }
+        vector<Item*> existing;
+        for (Shard& shard : shards) {
+            existing.insert(existing.end(), shard.items.begin(), shard.items.end());
+        }
+        sort(existing.begin(), existing.end(), [](const Item* a, const Item* b) { return a->id < b->id; });
+        index->onInsertBatch(existing);
+        indexes.push_back(index);
+    }
+
+    // Returns all items in insertion (ID) order
+    vector<Item*> snapshot() const {
+        // IDs are dense, so every item can be placed directly at slot id - 1
+        size_t limit = nextId.load() - 1;
+        vector<Item*> slots(limit, nullptr);
+        vector<Item*> shardCopy;
+        for (const Shard& shard : shards) {
+            {
+                // Only copy the pointers under the lock, so writers to this shard wait as little as possible
+                shared_lock<shared_mutex> lock(shard.mutex);
+                shardCopy.assign(shard.items.begin(), shard.items.end());
+            }
+            for (Item* item : shardCopy) {
+                if (item->id <= limit) {
+                    slots[item->id - 1] = item;
+                }
+            }
+        }
+        // Drop slots whose ID was reserved but not yet inserted when the snapshot was taken
+        slots.erase(remove(slots.begin(), slots.end(), nullptr), slots.end());
+        return slots;
+    }
+
+    // Returns all items of type T (including subclasses) in insertion order
+    template <typename T>
+    vector<T*> snapshotOf() const {
+        vector<T*> result;
+        for (Item* item : snapshot()) {
+            if (T* typed = dynamic_cast<T*>(item)) {
+                result.push_back(typed);
+            }
+        }
+        return result;
+    }
+
+    // Total number of modifications so far; persistence compares it to decide whether a save is needed
+    size_t changeCount() const {
+        return changes.load();
+    }
+
+    // Number of items currently stored
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> lock(shard.mutex);
+            total += shard.items.size();
+        }
+        return total;
+    }
+
+    // Number of item pointers the shards have room for
+    size_t slotCapacity() const {
+        size_t total = 0;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> lock(shard.mutex);
+            total += shard.items.capacity();
+        }
+        return total;
+    }
+
+    // Deletes every item; must not run concurrently with readers holding snapshots
+    void clear() {
+        for (Shard& shard : shards) {
+            unique_lock<shared_mutex> lock(shard.mutex);
+            for (Item* item : shard.items) {
+                delete item;
+            }
+            shard.items.clear();
+        }
+    }
+
+private:
+    struct Shard {
+        mutable shared_mutex mutex;
+        vector<Item*> items;
+    };
+
+    Shard shards[SHARD_COUNT];
+    atomic<size_t> nextId;
+    atomic<size_t> changes;
+    vector<ItemIndex*> indexes; // Changed only while every shard is locked
+};
+
+// Unbounded lock-free multi-producer single-consumer queue (Vyukov's linked-list design).
+// push() is wait-free: one atomic exchange and one store. Only a single thread may call pop().
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(new Node()), tail(head.load()) {}
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        T ignored;
+        while (pop(ignored)) {
+        }
+        delete tail;
+    }
+
+    void push(T value) {
+        Node* node = new Node();
+        node->value = move(value);
+        Node* previous = head.exchange(node, memory_order_acq_rel);
+        previous->next.store(node, memory_order_release); // Publishes the node to the consumer
+    }
+
+    // Consumer only: true if there is nothing to pop right now
+    bool empty() const {
+        return tail->next.load(memory_order_acquire) == nullptr;
+    }
+
+    // Returns false if the queue is empty (or a producer is between its two steps)
+    bool pop(T& value) {
+        Node* next = tail->next.load(memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        value = move(next->value);
+        delete tail;
+        tail = next; // The popped node becomes the new dummy
+        return true;
+    }
+
+private:
+    struct Node {
+        atomic<Node*> next{ nullptr };
+        T value{};
+    };
+
+    atomic<Node*> head; // Last pushed node, shared by producers
+    Node* tail;         // Dummy node before the oldest element, owned by the consumer
+};
+
+
+// Lets many threads create items without contending on the store: producers push into a
+// lock-free queue and a single applier thread drains it in batches with ItemStore::addBatch,
+// which also updates the indexes once per batch. Callers that need to know when their items are
+// stored (flush, submitAndWait) queue a flag of their own that the applier sets after the batch.
+class ItemIngestor {
+public:
+    explicit ItemIngestor(ItemStore& store, size_t maxBatch = 4096) :
+        store(store), maxBatch(maxBatch), stopping(false), applierSleeping(false), wakeups(0) {
+        applier = thread([this]() { applierLoop(); });
+    }
+
+    // Applies everything still queued before returning
+    ~ItemIngestor() {
+        stopping = true;
+        wake();
+        applier.join();
+    }
+
+    // Queues an item for insertion; safe to call from any number of threads
+    void submit(Item* item) {
+        queue.push({ item, nullptr });
+        atomic_thread_fence(memory_order_seq_cst); // Pairs with the fence in applierLoop so a sleeping applier is never missed
+        if (applierSleeping.load(memory_order_relaxed)) {
+            wake();
+        }
+    }
+
+    // Queues an item and blocks until the batch holding it is in the store; returns its ID
+    size_t submitAndWait(Item* item) {
+        bool stored = false;
+        queue.push({ item, &stored });
+        wake();
+        waitFor(stored);
+        return item->id;
+    }
+
+    // Blocks until every item this thread submitted before the call is in the store
+    void flush() {
+        bool reached = false;
+        queue.push({ nullptr, &reached }); // Marker: everything queued before it is applied first
+        wake();
+        waitFor(reached);
+    }
+
+private:
+    void wake() {
+        wakeups.fetch_add(1);
+        wakeups.notify_one();
+    }
+
+    // Entry of the queue; done, if set, belongs to a waiting caller and is set once the item is stored
+    struct Submission {
+        Item* item;  // nullptr for a flush marker
+        bool* done;
+    };
+
+    void waitFor(const bool& done) {
+        unique_lock<mutex> lock(completionMutex);
+        completed.wait(lock, [&]() { return done; });
+    }
+
+    void applierLoop() {
+        vector<Item*> batch;
+        vector<bool*> completions; // Flags of the waiting callers whose entries are in this batch
+        batch.reserve(maxBatch);
+        while (true) {
+            Submission submission;
+            while (batch.size() < maxBatch && queue.pop(submission)) {
+                if (submission.done) {
+                    completions.push_back(submission.done);
+                }
+                if (!submission.item) {
+                    break; // Apply what came before the marker before acknowledging it
+                }
+                batch.push_back(submission.item);
+            }
+            if (!batch.empty()) {
+                store.addBatch(batch);
+                batch.clear();
+            }
+            if (!completions.empty()) {
+                {
+                    // The flags live on the callers' stacks: set them under the mutex the callers
+                    // wait with, so none can return (and free its flag) before it is set
+                    lock_guard<mutex> lock(completionMutex);
+                    for (bool* done : completions) {
+                        *done = true;
+                    }
+                }
+                completed.notify_all();
+                completions.clear();
+                continue;
+            }
+            if (!queue.empty()) {
+                continue;
+            }
+            if (stopping.load()) {
+                return;
+            }
+
+            // Sleep until a producer signals; re-check the queue after announcing it to avoid lost wakeups
+            uint64_t seen = wakeups.load();
+            applierSleeping.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (queue.empty() && !stopping.load()) {
+                wakeups.wait(seen);
+            }
+            applierSleeping.store(false, memory_order_relaxed);
+        }
+    }
+
+    ItemStore& store;
+    size_t maxBatch;
+    MpscQueue<Submission> queue;
+    atomic<bool> stopping;
+    atomic<bool> applierSleeping;
+    atomic<uint64_t> wakeups;
+    mutex completionMutex;
+    condition_variable completed;
+    thread applier;
+};
+
+// Utility function to split strings based on a delimiter
+vector<string> split(const string& s, char delimiter) {
+    vector<string> tokens;
+    string token;
+    istringstream tokenStream(s);
+    while (getline(tokenStream, token, delimiter)) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+// Seconds elapsed since the given start time
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Parses one data.txt record into a new item; returns nullptr for blank or unknown lines
+Item* parseItemLine(const string& line) {
+    string type, title, description, deadline, tags, password, interval;
+    int priority = 0;
+    double progress = 0.0;
+
+    stringstream ss(line);  // Use stringstream for parsing the line
+    getline(ss, type, ',');  // Get the type of the item
+
+    if (type == "Task" || type == "RecurringTask" || type == "OneTimeTask") {
+        getline(ss, title, ',');
+        getline(ss, description, ',');
+        getline(ss, deadline, ',');
+        ss >> priority;
+        ss.ignore(1, ','); // Ignore the comma after reading priority
+        if (type == "RecurringTask") {
+            getline(ss, interval); // Read the interval
+            return new RecurringTask(title, description, deadline, priority, interval);
+        }
+        else if (type == "OneTimeTask") {
+            return new OneTimeTask(title, description, deadline, priority);
+        }
+        return new Task(title, description, deadline, priority);
+    }
+    else if (type == "Note" || type == "ProtectedNote" || type == "PublicNote") {
+        getline(ss, title, ',');
+        getline(ss, description, ',');
+        getline(ss, tags, ',');
+        vector<string> tagList = split(tags, ';'); // Multiple tags are stored separated by ';'
+        if (type == "ProtectedNote") {
+            getline(ss, password); // Read the password
+            return new ProtectedNote(title, description, tagList, password);
+        }
+        else if (type == "PublicNote") {
+            return new PublicNote(title, description, tagList);
+        }
+        return new Note(title, description, tagList);
+    }
+    else if (type == "Goal" || type == "QuantifiableGoal" || type == "NonQuantifiableGoal") {
+        getline(ss, title, ',');
+        getline(ss, description, ',');
+        ss >> progress;
+        if (type == "QuantifiableGoal") {
+            return new QuantifiableGoal(title, description, progress);
+        }
+        else if (type == "NonQuantifiableGoal") {
+            return new NonQuantifiableGoal(title, description, progress);
+        }
+        return new Goal(title, description, progress);
+    }
+    return nullptr;
+}
+
+// Function to load data from a file into the system
+void loadDataFromFile(const string& filename, ItemStore& store) {
+    TIME_OPERATION("load data");
+    ifstream file(filename);  // Open the file for reading
+    string line;
+    vector<Item*> loaded;
+
+    // Read each line from the file
+    {
+        TRACE_SPAN("read and parse lines");
+        while (getline(file, line)) {
+            if (Item* item = parseItemLine(line)) {
+                loaded.push_back(item);
+            }
+        }
+    }
+
+    file.close();  // Close the file after reading
+    TRACE_SPAN("insert items");
+    store.addBatch(loaded); // Insert everything at once so indexes are built in bulk
+}
+
+
+
+// Fixed-size pool of threads that run submitted jobs in FIFO order
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threadCount) : stopping(false) {
+        for (unsigned i = 0; i < max(1u, threadCount); i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void submit(function<void()> job) {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            jobs.push_back(move(job));
+        }
+        queueReady.notify_one();
+    }
+
+private:
+    void workerLoop() {
+        traceThreadName("worker");
+        while (true) {
+            function<void()> job;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                queueReady.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (jobs.empty()) {
+                    return; // Stopping and nothing left to run
+                }
+                job = move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    vector<thread> workers;
+    deque<function<void()>> jobs;
+    mutex queueMutex;
+    condition_variable queueReady;
+    bool stopping;
+};
+
+
+// Writes a file through a temporary next to it. commit() flushes the data to disk and renames the
+// temporary over the target, so after a crash the target holds either the old or the new contents.
+class AtomicFileWriter {
+public:
+    explicit AtomicFileWriter(const string& path) : path(path), tempPath(path + ".tmp"), failed(false), committed(false) {
+#ifdef _WIN32
+        fd = _open(tempPath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+        failed = fd < 0;
+    }
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    // An uncommitted temporary is discarded and the target is left untouched
+    ~AtomicFileWriter() {
+        if (!committed) {
+            closeFile();
+            remove(tempPath.c_str());
+        }
+    }
+
+    bool write(const char* data, size_t size) {
+        while (!failed && size > 0) {
+#ifdef _WIN32
+            int written = _write(fd, data, static_cast<unsigned>(min(size, static_cast<size_t>(1) << 30)));
+#else
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (written <= 0) {
+                failed = true;
+                break;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return !failed;
+    }
+
+    // Makes the new contents durable and visible under the target name; returns false on any error
+    bool commit() {
+        if (failed || committed) {
+            return false;
+        }
+#ifdef _WIN32
+        bool ok = _commit(fd) == 0;
+        ok = closeFile() && ok;
+        ok = ok && MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        bool ok = fsync(fd) == 0;
+        ok = closeFile() && ok;
+        ok = ok && rename(tempPath.c_str(), path.c_str()) == 0;
+        if (ok) {
+            // The rename itself is only durable once the directory entry is flushed
+            size_t slash = path.find_last_of('/');
+            string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+            int directoryFd = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+            if (directoryFd >= 0) {
+                fsync(directoryFd);
+                ::close(directoryFd);
+            }
+        }
+#endif
+        committed = ok;
+        return ok;
+    }
+
+private:
+    bool closeFile() {
+        if (fd < 0) {
+            return true;
+        }
+#ifdef _WIN32
+        bool ok = _close(fd) == 0;
+#else
+        bool ok = ::close(fd) == 0;
+#endif
+        fd = -1;
+        return ok;
+    }
+
+    string path;
+    string tempPath;
+    int fd;
+    bool failed;
+    bool committed;
+};
+
+// Coroutine type for the stages of the load/save pipelines.
+// A stage starts running as soon as it is called and frees itself when it finishes.
+struct PipelineStage {
+    struct promise_type {
+        PipelineStage get_return_object() { return PipelineStage(); }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+// Lets the caller block until a number of pipeline stages have finished
+class StageGroup {
+public:
+    explicit StageGroup(int stageCount) : remaining(stageCount) {}
+
+    void done() {
+        lock_guard<mutex> lock(groupMutex);
+        if (--remaining == 0) {
+            allDone.notify_all();
+        }
+    }
+
+    void wait() {
+        unique_lock<mutex> lock(groupMutex);
+        allDone.wait(lock, [this]() { return remaining == 0; });
+    }
+
+private:
+    mutex groupMutex;
+    condition_variable allDone;
+    int remaining;
+};
+
+// Awaitable that moves the awaiting coroutine onto a thread of the executor
+struct ScheduleOn {
+    WorkerPool& executor;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(coroutine_handle<> handle) { executor.submit([handle]() { handle.resume(); }); }
+    void await_resume() const noexcept {}
+};
+
+// Bounded channel between pipeline stages. push() suspends while the channel is full and
+// pop() suspends while it is empty, so a slow stage applies back-pressure without blocking threads.
+// The channel closes after every producer has called close(); pop() then returns nullopt.
+template <typename T>
+class AsyncChannel {
+public:
+    AsyncChannel(WorkerPool& executor, size_t capacity, int producerCount = 1) :
+        executor(executor), capacity(capacity), openProducers(producerCount) {}
+
+    struct PushAwaiter {
+        AsyncChannel& channel;
+        T value;
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(coroutine_handle<> handle) { return channel.suspendPush(handle, value); }
+        void await_resume() const noexcept {}
+    };
+
+    struct PopAwaiter {
+        AsyncChannel& channel;
+        optional<T> result;
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(coroutine_handle<> handle) { return channel.suspendPop(handle, result); }
+        optional<T> await_resume() { return move(result); }
+    };
+
+    PushAwaiter push(T value) {
+        return PushAwaiter{ *this, move(value) };
+    }
+
+    PopAwaiter pop() {
+        return PopAwaiter{ *this, nullopt };
+    }
+
+    void close() {
+        vector<coroutine_handle<>> wake;
+        {
+            lock_guard<mutex> lock(channelMutex);
+            if (--openProducers > 0) {
+                return;
+            }
+            for (auto& popper : poppers) {
+                wake.push_back(popper.handle); // Their result stays empty
+            }
+            poppers.clear();
+        }
+        for (auto handle : wake) {
+            resumeLater(handle);
+        }
+    }
+
+private:
+    struct WaitingPusher { coroutine_handle<> handle; T* value; };
+    struct WaitingPopper { coroutine_handle<> handle; optional<T>* result; };
+
+    // Returns true if the pusher must wait for space
+    bool suspendPush(coroutine_handle<> handle, T& value) {
+        coroutine_handle<> wake;
+        {
+            lock_guard<mutex> lock(channelMutex);
+            if (!poppers.empty()) {
+                *poppers.front().result = move(value); // Hand over directly to a waiting consumer
+                wake = poppers.front().handle;
+                poppers.pop_front();
+            }
+            else if (buffer.size() < capacity) {
+                buffer.push_back(move(value));
+            }
+            else {
+                pushers.push_back(WaitingPusher{ handle, &value });
+                return true;
+            }
+        }
+        if (wake) {
+            resumeLater(wake);
+        }
+        return false;
+    }
+
+    // Returns true if the consumer must wait for a value
+    bool suspendPop(coroutine_handle<> handle, optional<T>& result) {
+        coroutine_handle<> wake;
+        {
+            lock_guard<mutex> lock(channelMutex);
+            if (!buffer.empty()) {
+                result = move(buffer.front());
+                buffer.pop_front();
+                if (!pushers.empty()) {
+                    buffer.push_back(move(*pushers.front().value)); // Space freed: admit one waiting producer
+                    wake = pushers.front().handle;
+                    pushers.pop_front();
+                }
+            }
+            else if (openProducers == 0) {
+                return false; // Closed and drained
+            }
+            else {
+                poppers.push_back(WaitingPopper{ handle, &result });
+                return true;
+            }
+        }
+        if (wake) {
+            resumeLater(wake);
+        }
+        return false;
+    }
+
+    void resumeLater(coroutine_handle<> handle) {
+        executor.submit([handle]() { handle.resume(); });
+    }
+
+    WorkerPool& executor;
+    size_t capacity;
+    int openProducers;
+    mutex channelMutex;
+    deque<T> buffer;
+    deque<WaitingPusher> pushers;
+    deque<WaitingPopper> poppers;
+};
+
+// Piece of a file or of serialized output, numbered so order can be restored after parallel stages
+struct TextChunk {
+    size_t sequence;
+    string text;
+};
+
+// Items parsed from one chunk of the data file
+struct ItemChunk {
+    size_t sequence;
+    vector<Item*> items;
+};
+
+const size_t PIPELINE_BLOCK_BYTES = 1 << 20; // Read and write size of the pipelines
+const size_t PIPELINE_ITEMS_PER_CHUNK = 8192; // Items serialized per chunk when saving
+
+// Load stage 1: reads the file in large raw blocks
+PipelineStage readBlocksStage(WorkerPool& executor, istream& file, AsyncChannel<TextChunk>& out, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    for (size_t sequence = 0; ; sequence++) {
+        TextChunk block{ sequence, string(PIPELINE_BLOCK_BYTES, '\0') };
+        {
+            TRACE_SPAN("read block"); // Spans must end before a co_await, which may resume on another thread
+            file.read(&block.text[0], PIPELINE_BLOCK_BYTES);
+            block.text.resize(static_cast<size_t>(file.gcount()));
+        }
+        if (block.text.empty()) {
+            break;
+        }
+        co_await out.push(move(block));
+    }
+    out.close();
+    group.done();
+}
+
+// Load stage 2: decodes raw blocks into chunks that hold only whole lines
+PipelineStage decodeLinesStage(WorkerPool& executor, AsyncChannel<TextChunk>& in, AsyncChannel<TextChunk>& out, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    string carry; // Incomplete last line of the previous block
+    size_t sequence = 0;
+    while (optional<TextChunk> block = co_await in.pop()) {
+        size_t lastNewline = block->text.rfind('\n');
+        if (lastNewline == string::npos) {
+            carry += block->text;
+            continue;
+        }
+        TextChunk lines{ sequence++, move(carry) };
+        {
+            TRACE_SPAN("decode lines");
+            lines.text.append(block->text, 0, lastNewline + 1);
+            carry.assign(block->text, lastNewline + 1, string::npos);
+        }
+        co_await out.push(move(lines));
+    }
+    if (!carry.empty()) {
+        co_await out.push(TextChunk{ sequence, move(carry) });
+    }
+    out.close();
+    group.done();
+}
+
+// Load stage 3: parses lines and constructs the items; several instances run in parallel
+PipelineStage parseItemsStage(WorkerPool& executor, AsyncChannel<TextChunk>& in, AsyncChannel<ItemChunk>& out, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    while (optional<TextChunk> lines = co_await in.pop()) {
+        ItemChunk parsed{ lines->sequence, vector<Item*>() };
+        const string& text = lines->text;
+        string line;
+        {
+            TRACE_SPAN("parse chunk");
+            for (size_t start = 0; start < text.size(); ) {
+                size_t end = text.find('\n', start);
+                if (end == string::npos) {
+                    end = text.size();
+                }
+                line.assign(text, start, end - start);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (Item* item = parseItemLine(line)) {
+                    parsed.items.push_back(item);
+                }
+                start = end + 1;
+            }
+        }
+        co_await out.push(move(parsed));
+    }
+    out.close();
+    group.done();
+}
+
+// Load stage 4: restores file order and collects the constructed items
+PipelineStage collectItemsStage(WorkerPool& executor, AsyncChannel<ItemChunk>& in, vector<Item*>& loaded, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    map<size_t, vector<Item*>> early; // Chunks that overtook an earlier one
+    size_t nextSequence = 0;
+    while (optional<ItemChunk> chunk = co_await in.pop()) {
+        TRACE_SPAN("collect chunk");
+        early[chunk->sequence] = move(chunk->items);
+        for (auto it = early.begin(); it != early.end() && it->first == nextSequence; it = early.erase(it), nextSequence++) {
+            loaded.insert(loaded.end(), it->second.begin(), it->second.end());
+        }
+    }
+    group.done();
+}
+
+// Loads a data file like loadDataFromFile, but reading, line decoding, parsing and collection run as
+// overlapping coroutine stages on a small executor, so disk reads and parsing happen at the same time
+void loadDataPipelined(const string& filename, ItemStore& store, unsigned threadCount) {
+    TIME_OPERATION("load data (pipelined)");
+    ifstream file(filename, ios::binary);
+    unsigned parsers = max(1u, threadCount - 1);
+    WorkerPool executor(threadCount);
+    AsyncChannel<TextChunk> blocks(executor, 4);
+    AsyncChannel<TextChunk> lines(executor, 4);
+    AsyncChannel<ItemChunk> parsed(executor, 2 * parsers, parsers);
+    vector<Item*> loaded;
+
+    StageGroup group(3 + parsers);
+    readBlocksStage(executor, file, blocks, group);
+    decodeLinesStage(executor, blocks, lines, group);
+    for (unsigned p = 0; p < parsers; p++) {
+        parseItemsStage(executor, lines, parsed, group);
+    }
+    collectItemsStage(executor, parsed, loaded, group);
+    group.wait();
+
+    store.addBatch(loaded); // One atomic insert, exactly like the sequential loader
+}
+
+// Save stage 1: serializes chunks of items into data.txt text; several instances run in parallel
+PipelineStage serializeItemsStage(WorkerPool& executor, const ItemStore& store, const vector<Item*>& items, atomic<size_t>& nextChunk, AsyncChannel<TextChunk>& out, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    size_t chunkCount = (items.size() + PIPELINE_ITEMS_PER_CHUNK - 1) / PIPELINE_ITEMS_PER_CHUNK;
+    for (size_t chunk; (chunk = nextChunk++) < chunkCount; ) {
+        TextChunk text{ chunk, string() };
+        {
+            TRACE_SPAN("serialize chunk");
+            text.text.reserve(PIPELINE_ITEMS_PER_CHUNK * 96); // Typical records are well under 96 bytes
+            size_t end = min(items.size(), (chunk + 1) * PIPELINE_ITEMS_PER_CHUNK);
+            for (size_t i = chunk * PIPELINE_ITEMS_PER_CHUNK; i < end; i++) {
+                store.appendRecord(items[i], text.text);
+                text.text += '\n';
+            }
+        }
+        co_await out.push(move(text));
+    }
+    out.close();
+    group.done();
+}
+
+// Save stage 2: writes serialized chunks in item order using large writes
+PipelineStage writeChunksStage(WorkerPool& executor, AsyncChannel<TextChunk>& in, AtomicFileWriter& file, StageGroup& group) {
+    co_await ScheduleOn{ executor };
+    map<size_t, string> early;
+    size_t nextSequence = 0;
+    string pending;
+    while (optional<TextChunk> chunk = co_await in.pop()) {
+        early[chunk->sequence] = move(chunk->text);
+        for (auto it = early.begin(); it != early.end() && it->first == nextSequence; it = early.erase(it), nextSequence++) {
+            pending += it->second;
+        }
+        if (pending.size() >= PIPELINE_BLOCK_BYTES) {
+            TRACE_SPAN("write block");
+            file.write(pending.data(), pending.size());
+            pending.clear();
+        }
+    }
+    {
+        TRACE_SPAN("write block");
+        file.write(pending.data(), pending.size());
+    }
+    group.done();
+}
+
+// Writes the whole store in data.txt format with serialization and file writes overlapped
+bool saveDataPipelined(const string& filename, const ItemStore& store, unsigned threadCount) {
+    vector<Item*> items = store.snapshot();
+    AtomicFileWriter file(filename);
+    unsigned serializers = max(1u, threadCount - 1);
+    WorkerPool executor(threadCount);
+    AsyncChannel<TextChunk> chunks(executor, 2 * serializers, serializers);
+    atomic<size_t> nextChunk(0);
+
+    StageGroup group(1 + serializers);
+    for (unsigned s = 0; s < serializers; s++) {
+        serializeItemsStage(executor, store, items, nextChunk, chunks, group);
+    }
+    writeChunksStage(executor, chunks, file, group);
+    group.wait();
+    TRACE_SPAN("commit file"); // fsync and rename
+    return file.commit();
+}
+
+// Saves the whole store in data.txt format, replacing the file atomically.
+// Large stores go through the pipeline so several threads serialize while chunks are written;
+// small ones are serialized into a single buffer on the calling thread.
+bool saveDataToFile(const string& filename, const ItemStore& store) {
+    TIME_OPERATION("save data");
+    vector<Item*> items = store.snapshot();
+    if (items.size() >= 4 * PIPELINE_ITEMS_PER_CHUNK && thread::hardware_concurrency() > 1) {
+        return saveDataPipelined(filename, store, thread::hardware_concurrency());
+    }
+    string buffer;
+    {
+        TRACE_SPAN("serialize items");
+        for (Item* item : items) {
+            store.appendRecord(item, buffer);
+            buffer += '\n';
+        }
+    }
+    AtomicFileWriter file(filename);
+    file.write(buffer.data(), buffer.size());
+    TRACE_SPAN("commit file"); // fsync and rename
+    return file.commit();
+}
+
+
+// Persists the store as fixed-size segments of consecutive IDs plus a small manifest.
+// The storage is attached to the store as an index so it learns which segments changed;
+// save() rewrites only those segments, so its cost grows with the amount of change, not the store size.
+// Each segment file uses the data.txt format and is replaced atomically. The manifest is written
+// last and records how many items each segment holds, so a crash during a save reloads the
+// previous item set. If a segment file is missing or holds fewer items than the manifest says, the
+// loaded items would get shifted IDs, so saving is refused rather than overwrite the segments
+// (and the goal tree and progress history, which refer to items by ID) with a smaller store.
+class SegmentedStorage : public ItemIndex {
+public:
+    explicit SegmentedStorage(const string& directory, size_t segmentSize = 4096) :
+        directory(directory), segmentSize(segmentSize), lastWrittenSegments(0), damaged(false) {}
+
+    // Loads every segment into the store and starts tracking changes. Without a manifest the
+    // fallback data file is imported instead and every segment is written by the next save.
+    // Returns false if no manifest was found.
+    bool load(ItemStore& store, const string& fallbackFile) {
+        TIME_OPERATION("load segments");
+        error_code ignored;
+        filesystem::create_directories(directory, ignored);
+        ifstream manifest(segmentPath("manifest"));
+        string header, key;
+        size_t storedSegmentSize = 0, segmentCount = 0;
+        vector<Item*> loaded;
+        bool fromManifest = getline(manifest, header) && header == "GTN-SEGMENTS 1";
+        bool layoutMatches = fromManifest;
+        if (fromManifest) {
+            manifest >> key >> storedSegmentSize >> key >> segmentCount;
+            for (size_t segment = 0; segment < segmentCount; segment++) {
+                size_t index = 0, count = 0;
+                if (!(manifest >> key >> index >> count)) {
+                    cout << "Error: the manifest in " << directory << " is truncated after " << segment << " of " << segmentCount << " segments." << endl;
+                    damaged = true;
+                    break;
+                }
+                ifstream file(segmentPath(to_string(index)));
+                string line;
+                size_t read = 0;
+                while (read < count && getline(file, line)) {
+                    if (Item* item = parseItemLine(line)) {
+                        loaded.push_back(item);
+                        read++;
+                    }
+                }
+                onDisk.push_back(read);
+                if (read != count) {
+                    cout << "Error: " << segmentPath(to_string(index)) << (file.is_open() ? "" : " is missing and") << " holds " << read
+                        << " of its " << count << " items." << endl;
+                    damaged = true;
+                }
+                // IDs are reassigned densely on load, so they only line up with the files if every
+                // segment but the last is full and the segment size has not changed
+                if (index != segment || read != count || (segment + 1 < segmentCount && read != segmentSize)) {
+                    layoutMatches = false;
+                }
+            }
+            layoutMatches = layoutMatches && storedSegmentSize == segmentSize;
+            if (damaged) {
+                cout << "Saving to " << directory << " is disabled for this session so the segments are not overwritten;\n"
+                    << "restore the damaged files (or remove the manifest to import the fallback data file) and restart." << endl;
+            }
+        }
+        else {
+            ifstream file(fallbackFile);
+            string line;
+            while (getline(file, line)) {
+                if (Item* item = parseItemLine(line)) {
+                    loaded.push_back(item);
+                }
+            }
+        }
+
+        store.addBatch(loaded);
+        store.attachIndex(this); // Marks every loaded segment dirty
+        if (layoutMatches) {
+            lock_guard<mutex> lock(dirtyMutex);
+            dirty.clear(); // Exactly what is on disk
+        }
+        else {
+            onDisk.clear(); // Rewrite everything once with the new layout
+        }
+        return fromManifest;
+    }
+
+    // Writes the dirty segments and then the manifest; returns false if anything failed or the
+    // segments were found damaged on load
+    bool save(const ItemStore& store) {
+        TIME_OPERATION("save segments");
+        if (damaged) {
+            return false;
+        }
+        set<size_t> toWrite;
+        {
+            lock_guard<mutex> lock(dirtyMutex);
+            toWrite.swap(dirty);
+        }
+        bool ok = true;
+        for (size_t segment : toWrite) {
+            vector<Item*> items = store.findRange(segment * segmentSize + 1, (segment + 1) * segmentSize);
+            string buffer;
+            for (Item* item : items) {
+                store.appendRecord(item, buffer);
+                buffer += '\n';
+            }
+            AtomicFileWriter file(segmentPath(to_string(segment)));
+            file.write(buffer.data(), buffer.size());
+            if (file.commit()) {
+                if (onDisk.size() <= segment) {
+                    onDisk.resize(segment + 1, 0);
+                }
+                onDisk[segment] = items.size();
+            }
+            else {
+                ok = false;
+                lock_guard<mutex> lock(dirtyMutex);
+                dirty.insert(segment); // Retried by the next save
+            }
+        }
+        lastWrittenSegments = toWrite.size();
+        if (!ok || toWrite.empty()) {
+            return ok; // Keep the previous manifest when a segment is missing or nothing changed
+        }
+
+        string manifest = "GTN-SEGMENTS 1\nsegment-size " + to_string(segmentSize) + "\nsegments " + to_string(onDisk.size()) + "\n";
+        for (size_t segment = 0; segment < onDisk.size(); segment++) {
+            manifest += "segment " + to_string(segment) + " " + to_string(onDisk[segment]) + "\n";
+        }
+        AtomicFileWriter file(segmentPath("manifest"));
+        file.write(manifest.data(), manifest.size());
+        return file.commit();
+    }
+
+    void onInsert(Item* item) override {
+        lock_guard<mutex> lock(dirtyMutex);
+        dirty.insert(segmentOf(item->id));
+    }
+
+    void onInsertBatch(const vector<Item*>& items) override {
+        lock_guard<mutex> lock(dirtyMutex);
+        for (Item* item : items) {
+            dirty.insert(segmentOf(item->id));
+        }
+    }
+
+    void onUpdate(Item* item) override {
+        onInsert(item);
+    }
+
+    // Number of segments rewritten by the most recent save
+    size_t segmentsWrittenLastSave() const {
+        return lastWrittenSegments;
+    }
+
+    // Whether load found missing or short segments (saving is refused)
+    bool isDamaged() const {
+        return damaged;
+    }
+
+private:
+    size_t segmentOf(size_t id) const {
+        return (id - 1) / segmentSize;
+    }
+
+    string segmentPath(const string& name) const {
+        return directory + "/" + (name == "manifest" ? name : "segment-" + name) + ".txt";
+    }
+
+    string directory;
+    size_t segmentSize;
+    mutex dirtyMutex;
+    set<size_t> dirty;      // Segments changed since they were last written
+    vector<size_t> onDisk;  // Item count of each segment file as last written or loaded
+    size_t lastWrittenSegments;
+    bool damaged;
+};
+
+// Periodically saves the store from a background thread, so the menus never wait for a full save.
+// A checkpoint runs once the interval has passed or enough items changed, and only if something changed.
+class Checkpointer {
+public:
+    // save writes the store (whole file or dirty segments) and returns false on failure
+    Checkpointer(const ItemStore& store, function<bool()> save, double intervalSeconds, size_t dirtyThreshold) :
+        store(store), save(move(save)), intervalSeconds(intervalSeconds), dirtyThreshold(max<size_t>(1, dirtyThreshold)),
+        stopping(false), checkpoints(0), lastDurationSeconds(0) {
+        worker = thread([this]() { run(); });
+    }
+
+    // Stops the thread; a checkpoint in progress is finished first
+    ~Checkpointer() {
+        {
+            lock_guard<mutex> lock(stopMutex);
+            stopping = true;
+        }
+        stopRequested.notify_one();
+        worker.join();
+    }
+
+    size_t checkpointsWritten() const {
+        return checkpoints.load();
+    }
+
+    double lastCheckpointSeconds() const {
+        return lastDurationSeconds.load();
+    }
+
+private:
+    void run() {
+#ifdef __linux__
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10); // Yield the CPU to the interactive thread
+#endif
+        traceThreadName("checkpointer");
+        size_t savedChanges = store.changeCount(); // The freshly loaded state is already on disk
+        auto lastCheckpoint = chrono::steady_clock::now();
+        unique_lock<mutex> lock(stopMutex);
+        while (!stopping) {
+            stopRequested.wait_for(lock, chrono::milliseconds(100));
+            size_t current = store.changeCount();
+            size_t dirty = current - savedChanges;
+            if (stopping || dirty == 0 || (dirty < dirtyThreshold && secondsSince(lastCheckpoint) < intervalSeconds)) {
+                continue;
+            }
+
+            lock.unlock();
+            auto start = chrono::steady_clock::now();
+            if (save()) {
+                savedChanges = current;
+                checkpoints++;
+            }
+            lastDurationSeconds = secondsSince(start);
+            lastCheckpoint = chrono::steady_clock::now();
+            lock.lock();
+        }
+    }
+
+    const ItemStore& store;
+    function<bool()> save;
+    double intervalSeconds;
+    size_t dirtyThreshold;
+    mutex stopMutex;
+    condition_variable stopRequested;
+    bool stopping;
+    atomic<size_t> checkpoints;
+    atomic<double> lastDurationSeconds;
+    thread worker;
+};
+
+
+#ifndef _WIN32
+// Fixed-layout record of the memory-mapped store. Strings are NUL-terminated; items with a longer
+// field are rejected by append() rather than cut, which would corrupt sealed note bodies.
+// priority and progress are naturally aligned so in-place updates are single untearable stores;
+// the checksum covers only the fields that never change after the record is appended.
+// Notes get a longer body than tasks and goals since a protected note stores its sealed form,
+// "ENC1:" plus 48 bytes of salt and MAC and the ciphertext in hex: 113 plaintext bytes fit.
+struct MappedRecord {
+    uint32_t checksum;
+    uint8_t type;            // Index into MAPPED_TYPE_NAMES
+    uint8_t reserved[3];
+    int32_t priority;        // Tasks only; updated in place
+    uint32_t reserved2;
+    double progress;         // Goals only; updated in place
+    char title[80];
+    union {
+        struct {
+            char description[240];
+            char deadline[16];
+            char interval[64];   // Recurring tasks only
+        } task;
+        struct {
+            char body[328];      // Sealed for protected notes
+            char tags[80];       // Joined with ';' like in data.txt
+        } note;
+        struct {
+            char description[240];
+        } goal;
+    };
+};
+static_assert(sizeof(MappedRecord) == 512, "MappedRecord must keep its on-disk size");
+
+// Header in the first page of the mapped file
+struct MappedHeader {
+    char magic[8];           // "GTNMAP02"
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t capacity;       // Record slots available in the file
+    uint64_t count;          // Records published by the last flush(); later slots are ignored on open
+};
+
+const char* const MAPPED_TYPE_NAMES[] = { "", "Task", "RecurringTask", "OneTimeTask", "Note", "ProtectedNote", "PublicNote", "Goal", "QuantifiableGoal", "NonQuantifiableGoal" };
+const size_t MAPPED_HEADER_BYTES = 4096;
+
+// Alternative item store living in a memory-mapped file of fixed-size records. It is not a storage
+// backend of the menus, which always work on an ItemStore: it is reached through the "mmap" batch
+// commands and the startup benchmark.
+// Opening only maps the file, so startup does not depend on the store size: the OS pages records
+// in when they are first touched. Priority and progress changes are written in place.
+// Crash consistency: appended records become part of the store only when flush() has synced them
+// and then published the new count in the header, so a crash loses at most unflushed appends and
+// never exposes a half-written record. In-place updates are single aligned stores, so after a crash
+// a field holds either its old or its new value; flush() makes them durable.
+class MappedItemStore {
+public:
+    MappedItemStore() : fd(-1), base(nullptr), mappedBytes(0), pendingCount(0) {}
+    MappedItemStore(const MappedItemStore&) = delete;
+    MappedItemStore& operator=(const MappedItemStore&) = delete;
+
+    ~MappedItemStore() {
+        close();
+    }
+
+    // Opens (or creates) the store file; returns false if it cannot be mapped or is not a store
+    bool open(const string& path) {
+        close();
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close();
+            return false;
+        }
+        if (info.st_size == 0) {
+            // New store: header plus room for a first batch of records
+            if (!resize(64)) {
+                close();
+                return false;
+            }
+            MappedHeader* fresh = header();
+            memcpy(fresh->magic, "GTNMAP02", 8);
+            fresh->recordSize = sizeof(MappedRecord);
+            fresh->capacity = 64;
+            fresh->count = 0;
+            msync(base, MAPPED_HEADER_BYTES, MS_SYNC);
+        }
+        else if (!map(static_cast<size_t>(info.st_size))) {
+            close();
+            return false;
+        }
+        if (memcmp(header()->magic, "GTNMAP02", 8) != 0 || header()->recordSize != sizeof(MappedRecord) ||
+            MAPPED_HEADER_BYTES + header()->capacity * sizeof(MappedRecord) > mappedBytes || header()->count > header()->capacity) {
+            close();
+            return false;
+        }
+        pendingCount = header()->count;
+        return true;
+    }
+
+    void close() {
+        if (base) {
+            munmap(base, mappedBytes);
+            base = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    // Records visible to this process, including appends not yet flushed
+    size_t size() const {
+        return pendingCount;
+    }
+
+    // Appends the item as a new record and returns its index; visible to other opens after flush().
+    // Returns SIZE_MAX, with the reason in error, if a field does not fit its fixed size or the file cannot grow.
+    size_t append(const Item* item, string* error = nullptr) {
+        if (pendingCount == header()->capacity && !resize(header()->capacity * 2)) {
+            if (error) {
+                *error = "the store file cannot grow";
+            }
+            return SIZE_MAX;
+        }
+        MappedRecord& record = records()[pendingCount]; // Unpublished slot until pendingCount moves past it
+        memset(&record, 0, sizeof(record));
+        // Split the data.txt record; the last field (interval or password) may contain commas
+        string line = item->getRecord();
+        vector<string> fields;
+        size_t start = 0;
+        for (int field = 0; field < 5; field++) {
+            size_t comma = line.find(',', start);
+            fields.push_back(line.substr(start, comma - start));
+            if (comma == string::npos) {
+                start = line.size() + 1;
+                break;
+            }
+            start = comma + 1;
+        }
+        if (start <= line.size()) {
+            fields.push_back(line.substr(start));
+        }
+        fields.resize(6);
+        for (uint8_t type = 1; type < sizeof(MAPPED_TYPE_NAMES) / sizeof(MAPPED_TYPE_NAMES[0]); type++) {
+            if (fields[0] == MAPPED_TYPE_NAMES[type]) {
+                record.type = type;
+            }
+        }
+        bool fits = copyField(record.title, sizeof(record.title), fields[1], "title", error);
+        if (record.type <= 3) {
+            fits = fits && copyField(record.task.description, sizeof(record.task.description), fields[2], "description", error) &&
+                copyField(record.task.deadline, sizeof(record.task.deadline), fields[3], "deadline", error) &&
+                copyField(record.task.interval, sizeof(record.task.interval), fields[5], "recurrence interval", error);
+            record.priority = atoi(fields[4].c_str());
+        }
+        else if (record.type <= 6) {
+            // The password field of a protected note is always empty: the body is sealed instead
+            fits = fits && copyField(record.note.body, sizeof(record.note.body), fields[2], record.type == 5 ? "sealed body" : "description", error) &&
+                copyField(record.note.tags, sizeof(record.note.tags), fields[3], "tags", error);
+        }
+        else {
+            fits = fits && copyField(record.goal.description, sizeof(record.goal.description), fields[2], "description", error);
+            record.progress = atof(fields[3].c_str());
+        }
+        if (!fits) {
+            return SIZE_MAX;
+        }
+        record.checksum = checksumOf(record);
+        return pendingCount++;
+    }
+
+    // Builds a heap item from a record (caller owns it); nullptr for a bad index or corrupt record
+    Item* materialize(size_t index) const {
+        if (index >= pendingCount) {
+            return nullptr;
+        }
+        const MappedRecord& record = records()[index];
+        if (record.checksum != checksumOf(record) || record.type == 0 || record.type > 9) {
+            return nullptr;
+        }
+        string line = string(MAPPED_TYPE_NAMES[record.type]) + "," + record.title + ",";
+        if (record.type <= 3) {
+            line += string(record.task.description) + "," + record.task.deadline + "," + to_string(record.priority) +
+                (record.type == 2 ? "," + string(record.task.interval) : "");
+        }
+        else if (record.type <= 6) {
+            line += string(record.note.body) + "," + record.note.tags + (record.type == 5 ? "," : "");
+        }
+        else {
+            line += string(record.goal.description) + ",";
+            appendRecordNumber(line, record.progress);
+        }
+        return parseItemLine(line);
+    }
+
+    // In-place update of a task's priority; false if the record is not a task
+    bool setPriority(size_t index, int priority) {
+        if (index >= pendingCount || records()[index].type == 0 || records()[index].type > 3) {
+            return false;
+        }
+        records()[index].priority = priority;
+        return true;
+    }
+
+    // In-place update of a goal's progress; false if the record is not a goal
+    bool setProgress(size_t index, double progress) {
+        if (index >= pendingCount || records()[index].type < 7) {
+            return false;
+        }
+        records()[index].progress = progress;
+        return true;
+    }
+
+    // Makes appends and in-place updates durable: records are synced before the count that publishes them
+    bool flush() {
+        if (msync(base, mappedBytes, MS_SYNC) != 0) {
+            return false;
+        }
+        header()->count = pendingCount;
+        return msync(base, MAPPED_HEADER_BYTES, MS_SYNC) == 0;
+    }
+
+private:
+    MappedHeader* header() const {
+        return reinterpret_cast<MappedHeader*>(base);
+    }
+
+    MappedRecord* records() const {
+        return reinterpret_cast<MappedRecord*>(static_cast<char*>(base) + MAPPED_HEADER_BYTES);
+    }
+
+    // Copies value with its terminating NUL; false, with the reason in error, if it does not fit
+    static bool copyField(char* destination, size_t size, const string& value, const char* name, string* error) {
+        if (value.size() >= size) {
+            if (error) {
+                *error = string(name) + " is " + to_string(value.size()) + " bytes, at most " + to_string(size - 1) + " fit";
+            }
+            return false;
+        }
+        memcpy(destination, value.data(), value.size());
+        destination[value.size()] = '\0';
+        return true;
+    }
+
+    // FNV-1a over the type and the string fields
+    static uint32_t checksumOf(const MappedRecord& record) {
+        uint32_t hash = 2166136261u ^ record.type;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(record.title);
+        const unsigned char* end = reinterpret_cast<const unsigned char*>(&record + 1);
+        for (; bytes != end; bytes++) {
+            hash = (hash ^ *bytes) * 16777619u;
+        }
+        return hash;
+    }
+
+    bool map(size_t bytes) {
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        base = mapped;
+        mappedBytes = bytes;
+        return true;
+    }
+
+    // Grows the file to hold the given number of records and maps it again
+    bool resize(uint64_t capacity) {
+        size_t bytes = MAPPED_HEADER_BYTES + capacity * sizeof(MappedRecord);
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            return false;
+        }
+        if (base) {
+            munmap(base, mappedBytes);
+            base = nullptr;
+        }
+        if (!map(bytes)) {
+            return false;
+        }
+        header()->capacity = capacity; // New slots are zero and lie beyond the published count
+        return true;
+    }
+
+    int fd;
+    void* base;
+    size_t mappedBytes;
+    size_t pendingCount;
+};
+#endif
+
+// Reminder produced by DeadlineWheel: a task (or one occurrence of a recurring task) is due soon
+struct ReminderEvent {
+    Task* task;
+    int due; // Days since 1970-01-01
+};
+
+// Hierarchical timer wheel holding tasks keyed by the day their reminder fires (leadDays before the
+// deadline). Four levels of 64 one-day slots cover about 45,000 years. Attached to the store as an index,
+// so every added task is scheduled in O(1); advance() moves the wheel to a new day and returns every
+// reminder that became due in one batch. Entries in a higher level are redistributed to lower levels
+// only when the wheel reaches their slot, so each entry is touched a small constant number of times.
+// Recurring tasks are rescheduled for their next occurrence when a reminder fires. Tasks whose
+// deadline has already passed, or that have no valid date, get no reminder.
+class DeadlineWheel : public ItemIndex {
+public:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    DeadlineWheel(int today, int leadDays) : current(today), leadDays(leadDays), scheduled(0) {}
+
+    void onInsert(Item* item) override {
+        Task* task = dynamic_cast<Task*>(item);
+        if (!task) {
+            return;
+        }
+        lock_guard<mutex> lock(wheelMutex);
+        scheduleFirst(task);
+    }
+
+    void onInsertBatch(const vector<Item*>& items) override {
+        lock_guard<mutex> lock(wheelMutex);
+        for (Item* item : items) {
+            if (Task* task = dynamic_cast<Task*>(item)) {
+                scheduleFirst(task);
+            }
+        }
+    }
+
+    // Advances the wheel to the given day and returns every reminder that fired on the way
+    vector<ReminderEvent> advance(int today) {
+        lock_guard<mutex> lock(wheelMutex);
+        vector<ReminderEvent> fired;
+        fired.swap(pending);
+        rescheduleRecurring(fired, 0);
+        while (current < today) {
+            current++;
+            // Each time a level wraps around, the next slot of the level above is spread over the lower levels
+            int index = current & (SLOTS - 1);
+            for (int level = 1; level < LEVELS && index == 0; level++) {
+                index = (current >> (level * SLOT_BITS)) & (SLOTS - 1);
+                vector<Entry> cascading;
+                cascading.swap(slots[level][index]);
+                for (const Entry& entry : cascading) {
+                    place(entry);
+                }
+            }
+            vector<Entry>& due = slots[0][current & (SLOTS - 1)];
+            size_t firstNew = fired.size();
+            for (const Entry& entry : due) {
+                fired.push_back(ReminderEvent{ entry.task, entry.due });
+            }
+            scheduled -= due.size();
+            due.clear();
+            rescheduleRecurring(fired, firstNew);
+        }
+        return fired;
+    }
+
+    int today() const {
+        return current;
+    }
+
+    // Reminders waiting in the wheel
+    size_t size() const {
+        lock_guard<mutex> lock(wheelMutex);
+        return scheduled + pending.size();
+    }
+
+private:
+    struct Entry {
+        Task* task;
+        int fireDay;
+        int due;
+    };
+
+    void scheduleFirst(Task* task) {
+        int due;
+        if (RecurringTask* recurring = dynamic_cast<RecurringTask*>(task)) {
+            if (!recurring->recurrence.valid()) {
+                return;
+            }
+            // Without a start date the task recurs from today
+            due = recurring->recurrence.anchored ? recurring->recurrence.nextAfter(current - 1) : current;
+        }
+        else if (!parseDate(task->deadline, due)) {
+            return;
+        }
+        schedule(task, due);
+    }
+
+    void schedule(Task* task, int due) {
+        if (due < current) {
+            return; // Already overdue: nothing is coming up
+        }
+        Entry entry{ task, due - leadDays, due };
+        if (entry.fireDay <= current) {
+            pending.push_back(ReminderEvent{ task, due }); // Due within the lead time: report on the next advance
+            return;
+        }
+        place(entry);
+        scheduled++;
+    }
+
+    // Schedules the next occurrence of each recurring task among fired[from..]; occurrences that are
+    // already inside the lead time are appended to fired and handled in turn
+    void rescheduleRecurring(vector<ReminderEvent>& fired, size_t from) {
+        for (size_t i = from; i < fired.size(); i++) {
+            RecurringTask* recurring = dynamic_cast<RecurringTask*>(fired[i].task);
+            if (!recurring) {
+                continue;
+            }
+            int next = recurring->recurrence.nextAfter(fired[i].due);
+            if (next - leadDays <= current) {
+                fired.push_back(ReminderEvent{ recurring, next });
+            }
+            else {
+                place(Entry{ recurring, next - leadDays, next });
+                scheduled++;
+            }
+        }
+    }
+
+    // Puts an entry in the lowest level whose span covers its distance from the current day
+    void place(const Entry& entry) {
+        long long distance = static_cast<long long>(entry.fireDay) - current;
+        int level = 0;
+        while (level < LEVELS - 1 && distance >= (1LL << ((level + 1) * SLOT_BITS))) {
+            level++;
+        }
+        slots[level][(entry.fireDay >> (level * SLOT_BITS)) & (SLOTS - 1)].push_back(entry);
+    }
+
+    mutable mutex wheelMutex;
+    vector<Entry> slots[LEVELS][SLOTS];
+    vector<ReminderEvent> pending;
+    int current;
+    int leadDays;
+    size_t scheduled;
+};
+
+// One result of a date-range query: a task, or one occurrence of a recurring task
+struct DueItem {
+    Task* task;
+    int due; // Days since 1970-01-01
+};
+
+// Ordered index of task deadlines for calendar queries such as "due this week" or "overdue".
+// Tasks with a fixed deadline sit in a date-ordered multimap. Recurring tasks are grouped by rule shape
+// (unit, step, phase and day of month), ordered by first occurrence: all tasks of a group share their
+// occurrence dates, so a query visits only dates where some task occurs and, for each date, exactly
+// the tasks that started on or before it. A query costs O(g log n + k) for k results and g rule groups;
+// g depends on the kinds of intervals in use, not on the number of tasks.
+class DueDateIndex : public ItemIndex {
+public:
+    static constexpr int OPEN_START = numeric_limits<int>::min();
+    static constexpr int OPEN_END = numeric_limits<int>::max();
+
+    void onInsert(Item* item) override {
+        Task* task = dynamic_cast<Task*>(item);
+        if (!task) {
+            return;
+        }
+        lock_guard<mutex> lock(indexMutex);
+        RecurringTask* recurring = dynamic_cast<RecurringTask*>(task);
+        int due;
+        if (!recurring) {
+            if (parseDate(task->deadline, due)) {
+                byDeadline.insert(make_pair(due, task));
+            }
+        }
+        else if (recurring->recurrence.valid() && !recurring->recurrence.anchored) {
+            unanchored.push_back(recurring);
+        }
+        else if (recurring->recurrence.valid()) {
+            const RecurrenceRule& rule = recurring->recurrence;
+            int phase = rule.unit == RecurrenceRule::DAYS ? floorMod(rule.anchor, rule.step) : floorMod(rule.anchorMonth, rule.step);
+            RuleGroup& group = groups[make_tuple(static_cast<int>(rule.unit), rule.step, phase, rule.unit == RecurrenceRule::MONTHS ? rule.anchorDay : 0)];
+            group.rule = rule;
+            group.byStart.insert(make_pair(rule.anchor, recurring));
+        }
+    }
+
+    // Tasks and recurring occurrences due in [from, to], ordered by date. Either end may be open
+    // (OPEN_START, OPEN_END). With an open end each recurring task contributes only its next occurrence,
+    // and tasks without a start date recur from the range start (today when the start is open).
+    vector<DueItem> query(int from, int to, bool includeRecurring = true) const {
+        lock_guard<mutex> lock(indexMutex);
+        vector<DueItem> result;
+        for (auto it = byDeadline.lower_bound(from); it != byDeadline.end() && it->first <= to; ++it) {
+            result.push_back(DueItem{ it->second, it->first });
+        }
+        if (includeRecurring) {
+            for (const auto& entry : groups) {
+                appendGroupOccurrences(entry.second, from, to, result);
+            }
+            int start = from == OPEN_START ? currentDay() : from;
+            for (RecurringTask* task : unanchored) {
+                OccurrenceGenerator occurrences(task->recurrence, start, to == OPEN_END ? start : to);
+                for (int day; occurrences.next(day);) {
+                    result.push_back(DueItem{ task, day });
+                }
+            }
+            stable_sort(result.begin(), result.end(), [](const DueItem& a, const DueItem& b) { return a.due < b.due; });
+        }
+        return result;
+    }
+
+    // Tasks whose deadline is before today. Recurring tasks never become overdue: they move on to
+    // their next occurrence.
+    vector<DueItem> overdue(int today) const {
+        return query(OPEN_START, today - 1, false);
+    }
+
+private:
+    struct RuleGroup {
+        RecurrenceRule rule;                      // Any member's rule; only the shape is used
+        multimap<int, RecurringTask*> byStart;    // First occurrence -> task
+    };
+
+    static int floorMod(int value, int divisor) {
+        return ((value % divisor) + divisor) % divisor;
+    }
+
+    void appendGroupOccurrences(const RuleGroup& group, int from, int to, vector<DueItem>& result) const {
+        int firstStart = group.byStart.begin()->first;
+        if (to == OPEN_END) {
+            // Open end: only the next occurrence of each task that has started by then
+            for (const auto& entry : group.byStart) {
+                int next = entry.second->recurrence.nextAfter(max(from, entry.first) - 1);
+                result.push_back(DueItem{ entry.second, next });
+            }
+            return;
+        }
+        if (firstStart > to) {
+            return;
+        }
+        // Every member occurs on the group's dates from its own start on, so walking the dates of the
+        // earliest member and emitting the prefix of members started by each date visits only results
+        RecurrenceRule walker = group.rule.anchoredAt(firstStart);
+        for (int day = walker.nextAfter(max(from, firstStart) - 1); day <= to; day = walker.nextAfter(day)) {
+            for (auto it = group.byStart.begin(); it != group.byStart.end() && it->first <= day; ++it) {
+                result.push_back(DueItem{ it->second, day });
+            }
+        }
+    }
+
+    mutable mutex indexMutex;
+    multimap<int, Task*> byDeadline;
+    map<tuple<int, int, int, unsigned>, RuleGroup> groups;
+    vector<RecurringTask*> unanchored;
+};
+
+// One point of a goal's progress history
+struct ProgressPoint {
+    int64_t time;    // Seconds since 1970-01-01 UTC
+    double progress; // 0 to 1
+};
+
+// Progress of a goal in one week
+struct WeeklyProgress {
+    int weekStart;   // Monday, in days since 1970-01-01
+    double progress; // Last value recorded by the end of the week (carried over from earlier weeks)
+    size_t updates;  // Updates recorded during the week
+};
+
+// Compressed progress history of one goal. Timestamps are stored as delta-of-delta and progress as
+// the change in fixed-point hundredths of a percent, both as zigzag varints, so regular updates with
+// small changes take two to four bytes per point. Every 128 points the decoder state is kept in a
+// small index, so range reads start decoding near the requested time instead of at the first point.
+class ProgressSeries {
+public:
+    static const uint32_t BLOCK_POINTS = 128;
+
+    // Appends a point; times earlier than the last point are moved up to it so the series stays ordered
+    void append(int64_t time, double progress) {
+        int32_t value = static_cast<int32_t>(llround(progress * 10000));
+        if (count == 0) {
+            firstTime = lastTime = time;
+            firstValue = lastValue = value;
+            count = 1;
+            return;
+        }
+        time = max(time, lastTime);
+        if (count % BLOCK_POINTS == 0) {
+            blocks.push_back(Block{ lastTime, lastDelta, lastValue, static_cast<uint32_t>(bytes.size()) });
+        }
+        int64_t delta = time - lastTime;
+        appendVarint(zigzag(delta - lastDelta));
+        appendVarint(zigzag(static_cast<int64_t>(value) - lastValue));
+        lastTime = time;
+        lastDelta = delta;
+        lastValue = value;
+        count++;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Calls visit(time, progress) for the points in time order, starting at or shortly before the point
+    // before "from" so the caller knows the value in effect at "from"; stops when visit returns false
+    template <typename Visit>
+    void decodeFrom(int64_t from, Visit visit) const {
+        if (count == 0) {
+            return;
+        }
+        // Last block whose preceding point is before "from"
+        auto block = upper_bound(blocks.begin(), blocks.end(), from, [](int64_t time, const Block& b) { return time <= b.prevTime; });
+        int64_t time = firstTime, delta = 0;
+        int32_t value = firstValue;
+        size_t offset = 0;
+        if (block != blocks.begin()) {
+            --block;
+            time = block->prevTime;
+            delta = block->prevDelta;
+            value = block->prevValue;
+            offset = block->offset;
+        }
+        if (!visit(time, value / 10000.0)) {
+            return;
+        }
+        while (offset < bytes.size()) {
+            delta += unzigzag(readVarint(offset));
+            time += delta;
+            value += static_cast<int32_t>(unzigzag(readVarint(offset)));
+            if (!visit(time, value / 10000.0)) {
+                return;
+            }
+        }
+    }
+
+    // Points with from <= time <= to, oldest first
+    void read(int64_t from, int64_t to, vector<ProgressPoint>& out) const {
+        decodeFrom(from, [&](int64_t time, double progress) {
+            if (time > to) {
+                return false;
+            }
+            if (time >= from) {
+                out.push_back(ProgressPoint{ time, progress });
+            }
+            return true;
+        });
+    }
+
+    size_t memoryBytes() const {
+        return sizeof(*this) + bytes.capacity() + blocks.capacity() * sizeof(Block);
+    }
+
+private:
+    struct Block {
+        int64_t prevTime;  // Decoder state after the point before the block
+        int64_t prevDelta;
+        int32_t prevValue;
+        uint32_t offset;   // Byte offset of the block's first point
+    };
+
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    void appendVarint(uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint64_t readVarint(size_t& offset) const {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = bytes[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+    int64_t firstTime = 0, lastTime = 0, lastDelta = 0;
+    int32_t firstValue = 0, lastValue = 0;
+    uint32_t count = 0;
+    vector<uint8_t> bytes;
+    vector<Block> blocks;
+};
+
+// Progress histories of all goals, keyed by goal ID. Goal IDs are stable across runs because items are
+// saved and reloaded in ID order, so the history is kept in its own file next to the data.
+class ProgressHistory {
+public:
+    void record(size_t goalId, int64_t time, double progress) {
+        lock_guard<mutex> lock(historyMutex);
+        series[goalId].append(time, progress);
+    }
+
+    // Updates of one goal with from <= time <= to
+    vector<ProgressPoint> range(size_t goalId, int64_t from, int64_t to) const {
+        lock_guard<mutex> lock(historyMutex);
+        vector<ProgressPoint> points;
+        auto found = series.find(goalId);
+        if (found != series.end()) {
+            found->second.read(from, to, points);
+        }
+        return points;
+    }
+
+    // One entry per week from the week of fromDay to the week of toDay. Weeks before the first
+    // recorded update are left out.
+    vector<WeeklyProgress> weekly(size_t goalId, int fromDay, int toDay) const {
+        lock_guard<mutex> lock(historyMutex);
+        vector<WeeklyProgress> weeks;
+        auto found = series.find(goalId);
+        if (found == series.end()) {
+            return weeks;
+        }
+        int firstWeek = fromDay - (fromDay + 3) % 7; // 1970-01-01 was a Thursday
+        int lastWeek = toDay - (toDay + 3) % 7;
+        double current = -1; // No value yet
+        int week = firstWeek;
+        size_t updates = 0;
+        auto closeWeeksBefore = [&](int64_t time) {
+            while (week <= lastWeek && time >= (week + 7) * 86400LL) {
+                if (current >= 0) {
+                    weeks.push_back(WeeklyProgress{ week, current, updates });
+                }
+                week += 7;
+                updates = 0;
+            }
+        };
+        found->second.decodeFrom(firstWeek * 86400LL, [&](int64_t time, double progress) {
+            closeWeeksBefore(time);
+            if (week > lastWeek) {
+                return false;
+            }
+            updates += time >= week * 86400LL;
+            current = progress;
+            return true;
+        });
+        closeWeeksBefore(numeric_limits<int64_t>::max());
+        return weeks;
+    }
+
+    size_t pointCount() const {
+        lock_guard<mutex> lock(historyMutex);
+        size_t points = 0;
+        for (const auto& entry : series) {
+            points += entry.second.size();
+        }
+        return points;
+    }
+
+    // Encoded series plus the map's own overhead (estimated per entry)
+    size_t memoryBytes() const {
+        lock_guard<mutex> lock(historyMutex);
+        size_t total = series.bucket_count() * sizeof(void*);
+        for (const auto& entry : series) {
+            total += entry.second.memoryBytes() + sizeof(size_t) + 2 * sizeof(void*);
+        }
+        return total;
+    }
+
+    // Writes every series as its decoded points (goal ID, count, then time/value pairs), replacing the file atomically
+    bool save(const string& filename) const {
+        lock_guard<mutex> lock(historyMutex);
+        string out = "GTN-PROGRESS 1\n";
+        for (const auto& entry : series) {
+            appendRecordNumber(out, entry.first);
+            out += ' ';
+            appendRecordNumber(out, entry.second.size());
+            entry.second.decodeFrom(numeric_limits<int64_t>::min(), [&](int64_t time, double progress) {
+                out += ' ';
+                appendRecordNumber(out, time);
+                out += ' ';
+                appendRecordNumber(out, progress);
+                return true;
+            });
+            out += '\n';
+        }
+        AtomicFileWriter file(filename);
+        return file.write(out.data(), out.size()) && file.commit();
+    }
+
+    // Loads a file written by save(); a missing or unreadable file leaves the history empty
+    void load(const string& filename) {
+        ifstream in(filename);
+        string line;
+        if (!getline(in, line) || line != "GTN-PROGRESS 1") {
+            return;
+        }
+        lock_guard<mutex> lock(historyMutex);
+        while (getline(in, line)) {
+            istringstream fields(line);
+            size_t goalId, points;
+            if (!(fields >> goalId >> points)) {
+                continue;
+            }
+            ProgressSeries& goalSeries = series[goalId];
+            int64_t time;
+            double progress;
+            for (size_t i = 0; i < points && fields >> time >> progress; i++) {
+                goalSeries.append(time, progress);
+            }
+        }
+    }
+
+private:
+    mutable mutex historyMutex;
+    unordered_map<size_t, ProgressSeries> series;
+};
+
+// Name of an item's type as used in data.txt records
+const char* itemTypeName(const Item* item) {
+    if (dynamic_cast<const RecurringTask*>(item)) {
+        return "RecurringTask";
+    }
+    if (dynamic_cast<const OneTimeTask*>(item)) {
+        return "OneTimeTask";
+    }
+    if (dynamic_cast<const Task*>(item)) {
+        return "Task";
+    }
+    if (dynamic_cast<const ProtectedNote*>(item)) {
+        return "ProtectedNote";
+    }
+    if (dynamic_cast<const PublicNote*>(item)) {
+        return "PublicNote";
+    }
+    if (dynamic_cast<const Note*>(item)) {
+        return "Note";
+    }
+    if (dynamic_cast<const QuantifiableGoal*>(item)) {
+        return "QuantifiableGoal";
+    }
+    if (dynamic_cast<const NonQuantifiableGoal*>(item)) {
+        return "NonQuantifiableGoal";
+    }
+    return "Goal";
+}
+
+// Dashboard figures kept up to date by the store: item counts per type, tasks per priority, goal
+// progress per goal type, notes per tag and deadlines per week. Every change adds or subtracts one
+// item's contribution, and values are kept as ordered value -> count maps so min and max stay exact
+// when an item's contribution is subtracted. display() therefore costs O(buckets), not O(items).
+class DashboardAggregates : public ItemIndex {
+public:
+    void onInsert(Item* item) override {
+        lock_guard<mutex> lock(aggregateMutex);
+        apply(item, 1);
+    }
+
+    void onInsertBatch(const vector<Item*>& items) override {
+        lock_guard<mutex> lock(aggregateMutex);
+        for (Item* item : items) {
+            apply(item, 1);
+        }
+    }
+
+    void onBeforeUpdate(Item* item) override {
+        lock_guard<mutex> lock(aggregateMutex);
+        apply(item, -1);
+    }
+
+    void onUpdate(Item* item) override {
+        lock_guard<mutex> lock(aggregateMutex);
+        apply(item, 1);
+    }
+
+    // Prints the dashboard; deadlines are shown for the eight weeks from the week of today
+    void display(int today) const {
+        lock_guard<mutex> lock(aggregateMutex);
+        cout << "Items by type:\n";
+        for (const auto& entry : typeCounts) {
+            cout << "  " << left << setw(22) << entry.first << right << entry.second << "\n";
+        }
+        cout << "Tasks per priority:";
+        for (const auto& entry : priorities.values) {
+            cout << "  " << entry.first << ": " << entry.second;
+        }
+        cout << "\n";
+        if (priorities.count > 0) {
+            cout << fixed << setprecision(1) << "  average " << priorities.sum / priorities.count << ", min " << priorities.values.begin()->first
+                << ", max " << priorities.values.rbegin()->first << "\n";
+        }
+        cout << "Goal progress by type:\n";
+        for (const auto& entry : goalProgress) {
+            const ValueStats& stats = entry.second;
+            cout << "  " << left << setw(22) << entry.first << right << stats.count << " goals";
+            if (stats.count > 0) {
+                cout << fixed << setprecision(0) << ", average " << stats.sum / stats.count / 100 << "%, min " << stats.values.begin()->first / 100.0
+                    << "%, max " << stats.values.rbegin()->first / 100.0 << "%";
+            }
+            cout << "\n";
+        }
+        cout << "Notes per tag:";
+        for (const auto& entry : tagCounts) {
+            cout << "  " << entry.first << ": " << entry.second;
+        }
+        cout << "\nDeadlines per week:\n";
+        int thisWeek = today - (today + 3) % 7; // 1970-01-01 was a Thursday
+        long long earlier = 0, later = 0;
+        for (const auto& entry : deadlineWeeks) {
+            if (entry.first < thisWeek) {
+                earlier += entry.second;
+            }
+            else if (entry.first >= thisWeek + 56) {
+                later += entry.second;
+            }
+        }
+        cout << "  before " << formatDate(thisWeek) << ": " << earlier << "\n";
+        for (int week = thisWeek; week < thisWeek + 56; week += 7) {
+            auto found = deadlineWeeks.find(week);
+            cout << "  week of " << formatDate(week) << ": " << (found == deadlineWeeks.end() ? 0 : found->second) << "\n";
+        }
+        cout << "  later: " << later << "\n";
+    }
+
+private:
+    // Count, sum and value distribution of one figure
+    struct ValueStats {
+        long long count = 0;
+        double sum = 0;
+        map<long long, long long> values; // Value -> number of items with it
+
+        void add(long long value, int sign) {
+            count += sign;
+            sum += static_cast<double>(value) * sign;
+            if ((values[value] += sign) == 0) {
+                values.erase(value);
+            }
+        }
+    };
+
+    template <typename Key>
+    static void addCount(map<Key, long long>& counts, const Key& key, int sign) {
+        if ((counts[key] += sign) == 0) {
+            counts.erase(key);
+        }
+    }
+
+    // Adds (sign 1) or subtracts (sign -1) the item's contribution
+    void apply(Item* item, int sign) {
+        addCount(typeCounts, string(itemTypeName(item)), sign);
+        if (Task* task = dynamic_cast<Task*>(item)) {
+            priorities.add(task->priority, sign);
+            int due;
+            if (parseDate(task->deadline, due)) {
+                addCount(deadlineWeeks, due - (due + 3) % 7, sign);
+            }
+        }
+        else if (Goal* goal = dynamic_cast<Goal*>(item)) {
+            if (goal->getProgress() != -1) { // Non-quantifiable goals have no progress to aggregate
+                goalProgress[itemTypeName(item)].add(llround(goal->getProgress() * 10000), sign);
+            }
+        }
+        else if (Note* note = dynamic_cast<Note*>(item)) {
+            for (const string& tag : note->tags) {
+                addCount(tagCounts, tag, sign);
+            }
+        }
+    }
+
+    mutable mutex aggregateMutex;
+    map<string, long long> typeCounts;
+    ValueStats priorities;
+    map<string, ValueStats> goalProgress; // Progress in hundredths of a percent
+    map<string, long long> tagCounts;
+    map<int, long long> deadlineWeeks;    // Monday of the week -> tasks due that week
+};
+
+// Parent/child relationships between goals with incremental progress roll-up.
+// A goal with quantifiable sub-goals has the weighted average of their rolled-up progress; a leaf
+// has its own progress. Each parent keeps the sum of its children's weights and of weight * progress,
+// so a change anywhere only adjusts those sums on the path to the root: O(depth), with no recursion,
+// so deep hierarchies are fine. Non-quantifiable goals can be sub-goals but are not weighted.
+class GoalTree {
+public:
+    // Makes child a sub-goal of parent (moving it from any previous parent); false if that would create a cycle
+    bool link(Goal* child, Goal* parent, double weight) {
+        lock_guard<mutex> lock(treeMutex);
+        for (Goal* ancestor = parent; ancestor; ancestor = ancestor->parentGoal) {
+            if (ancestor == child) {
+                return false;
+            }
+        }
+        detach(child);
+        child->parentGoal = parent;
+        child->weight = weight;
+        parent->subGoals.push_back(child);
+        if (contributes(child)) {
+            double before = parent->rolledUpProgress();
+            parent->childWeight += weight;
+            parent->childWeightedProgress += weight * child->rolledUpProgress();
+            propagate(parent, before);
+        }
+        return true;
+    }
+
+    // Makes the goal a top-level goal again
+    void unlink(Goal* child) {
+        lock_guard<mutex> lock(treeMutex);
+        detach(child);
+    }
+
+    // Sets a goal's own progress and updates its ancestors
+    void setProgress(Goal* goal, double progress) {
+        lock_guard<mutex> lock(treeMutex);
+        double before = goal->rolledUpProgress();
+        goal->setProgress(progress);
+        propagate(goal, before);
+    }
+
+    double progressOf(const Goal* goal) const {
+        lock_guard<mutex> lock(treeMutex);
+        return goal->rolledUpProgress();
+    }
+
+    // Prints every top-level goal with its sub-goals indented below it
+    void display(const vector<Goal*>& goals) const {
+        lock_guard<mutex> lock(treeMutex);
+        vector<pair<const Goal*, int>> pending; // Goal and depth, explicit stack instead of recursion
+        for (auto it = goals.rbegin(); it != goals.rend(); ++it) {
+            if (!(*it)->parentGoal) {
+                pending.push_back(make_pair(*it, 0));
+            }
+        }
+        while (!pending.empty()) {
+            const Goal* goal = pending.back().first;
+            int depth = pending.back().second;
+            pending.pop_back();
+            cout << string(2 * min(depth, 40), ' ') << goal->title;
+            if (goal->rolledUpProgress() == -1) {
+                cout << ": progress not quantified";
+            }
+            else {
+                cout << ": " << fixed << setprecision(0) << goal->rolledUpProgress() * 100 << "%";
+            }
+            if (goal->parentGoal) {
+                cout << " (weight " << setprecision(2) << goal->weight << ")";
+            }
+            cout << "\n";
+            for (auto it = goal->subGoals.rbegin(); it != goal->subGoals.rend(); ++it) {
+                pending.push_back(make_pair(*it, depth + 1));
+            }
+        }
+    }
+
+    // Saves the links as "child-id parent-id weight" lines, replacing the file atomically
+    bool save(const string& filename, const ItemStore& store) const {
+        vector<Goal*> goals = store.snapshotOf<Goal>(); // Before taking the tree lock: updates hold a shard lock while linking
+        lock_guard<mutex> lock(treeMutex);
+        string out = "GTN-GOALTREE 1\n";
+        for (Goal* goal : goals) {
+            if (goal->parentGoal) {
+                appendRecordNumber(out, goal->id);
+                out += ' ';
+                appendRecordNumber(out, goal->parentGoal->id);
+                out += ' ';
+                appendRecordNumber(out, goal->weight);
+                out += '\n';
+            }
+        }
+        AtomicFileWriter file(filename);
+        return file.write(out.data(), out.size()) && file.commit();
+    }
+
+    // Restores the links saved by save() into goals without links; links to missing goals are skipped.
+    // The roll-up is built in one bottom-up pass instead of link by link, so loading costs O(goals)
+    // however deep the hierarchy is. A link that would close a cycle is dropped.
+    void load(const string& filename, ItemStore& store) {
+        ifstream in(filename);
+        string line;
+        if (!getline(in, line) || line != "GTN-GOALTREE 1") {
+            return;
+        }
+        lock_guard<mutex> lock(treeMutex);
+        vector<Goal*> linked;
+        size_t childId, parentId;
+        double weight;
+        while (in >> childId >> parentId >> weight) {
+            Goal* child = dynamic_cast<Goal*>(store.find(childId));
+            Goal* parent = dynamic_cast<Goal*>(store.find(parentId));
+            if (child && parent && child != parent && !child->parentGoal) {
+                child->parentGoal = parent;
+                child->weight = weight;
+                parent->subGoals.push_back(child);
+                linked.push_back(child);
+            }
+        }
+
+        // Order the goals so that every parent comes before its sub-goals
+        vector<Goal*> order;
+        unordered_set<Goal*> visited;
+        auto visitFrom = [&](Goal* root) {
+            size_t next = order.size();
+            order.push_back(root);
+            visited.insert(root);
+            for (; next < order.size(); next++) {
+                for (Goal* sub : order[next]->subGoals) {
+                    if (visited.insert(sub).second) {
+                        order.push_back(sub);
+                    }
+                }
+            }
+        };
+        for (Goal* child : linked) {
+            Goal* root = child->parentGoal;
+            if (!root->parentGoal && !visited.count(root)) {
+                visitFrom(root);
+            }
+        }
+        for (Goal* child : linked) {
+            if (!visited.count(child)) { // Only reachable through a cycle: cut the cycle here
+                Goal* parent = child->parentGoal;
+                parent->subGoals.erase(find(parent->subGoals.begin(), parent->subGoals.end(), child));
+                child->parentGoal = nullptr;
+                visitFrom(child);
+            }
+        }
+
+        // Sub-goals before parents, so every rolled-up value is final when it is added to its parent
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            Goal* goal = *it;
+            if (goal->parentGoal && contributes(goal)) {
+                goal->parentGoal->childWeight += goal->weight;
+                goal->parentGoal->childWeightedProgress += goal->weight * goal->rolledUpProgress();
+            }
+        }
+    }
+
+private:
+    static bool contributes(const Goal* goal) {
+        return goal->getProgress() != -1; // Non-quantifiable goals are left out of the weighting
+    }
+
+    // Removes the child's contribution from its parent, if it has one
+    void detach(Goal* child) {
+        Goal* parent = child->parentGoal;
+        if (!parent) {
+            return;
+        }
+        parent->subGoals.erase(find(parent->subGoals.begin(), parent->subGoals.end(), child));
+        child->parentGoal = nullptr;
+        if (contributes(child)) {
+            double before = parent->rolledUpProgress();
+            parent->childWeight -= child->weight;
+            parent->childWeightedProgress -= child->weight * child->rolledUpProgress();
+            if (parent->subGoals.empty() || parent->childWeight <= 0) {
+                parent->childWeight = parent->childWeightedProgress = 0; // Drop rounding leftovers
+            }
+            propagate(parent, before);
+        }
+    }
+
+    // The goal's rolled-up progress changed from "before"; adjusts the weighted sums up to the root
+    void propagate(Goal* goal, double before) {
+        double delta = goal->rolledUpProgress() - before;
+        while (delta != 0 && goal->parentGoal && contributes(goal)) {
+            Goal* parent = goal->parentGoal;
+            double parentBefore = parent->rolledUpProgress();
+            parent->childWeightedProgress += goal->weight * delta;
+            delta = parent->rolledUpProgress() - parentBefore;
+            goal = parent;
+        }
+    }
+
+    mutable mutex treeMutex;
+};
+
+// Bytes the allocator really uses for a block: the usable size plus the chunk header with glibc/musl,
+// otherwise an estimate for a 16-byte aligned allocator with an 8-byte header
+size_t heapBlockBytes(const void* block, size_t requested) {
+#ifdef __linux__
+    (void)requested;
+    return malloc_usable_size(const_cast<void*>(block)) + sizeof(size_t);
+#else
+    (void)block;
+    return max<size_t>(32, (requested + sizeof(size_t) + 15) & ~size_t(15));
+#endif
+}
+
+// Size of the item's most derived class
+size_t itemObjectSize(const Item* item) {
+    if (dynamic_cast<const RecurringTask*>(item)) {
+        return sizeof(RecurringTask);
+    }
+    if (dynamic_cast<const OneTimeTask*>(item)) {
+        return sizeof(OneTimeTask);
+    }
+    if (dynamic_cast<const Task*>(item)) {
+        return sizeof(Task);
+    }
+    if (dynamic_cast<const ProtectedNote*>(item)) {
+        return sizeof(ProtectedNote);
+    }
+    if (dynamic_cast<const PublicNote*>(item)) {
+        return sizeof(PublicNote);
+    }
+    if (dynamic_cast<const Note*>(item)) {
+        return sizeof(Note);
+    }
+    if (dynamic_cast<const QuantifiableGoal*>(item)) {
+        return sizeof(QuantifiableGoal);
+    }
+    if (dynamic_cast<const NonQuantifiableGoal*>(item)) {
+        return sizeof(NonQuantifiableGoal);
+    }
+    return sizeof(Goal);
+}
+
+// Memory used by the stored items, by item type and field category. Inline fields (including
+// short strings kept inside the object) count under "fields"; heap buffers count under the field
+// they belong to at their requested size, and whatever the allocator adds on top (headers and
+// rounding) under "malloc".
+class MemoryReport {
+public:
+    enum Category { VPTR, FIELDS, TITLE, DESCRIPTION, TAGS, OTHER_STRINGS, SUB_GOALS, MALLOC, CATEGORY_COUNT };
+
+    explicit MemoryReport(const ItemStore& store) : slotBytes(store.slotCapacity() * sizeof(Item*)) {
+        for (const Item* item : store.snapshot()) {
+            add(item);
+        }
+    }
+
+    void display() const {
+        static const char* const headings[CATEGORY_COUNT] = { "vptr", "fields", "title", "descr", "tags", "other", "links", "malloc" };
+        Usage all;
+        for (const auto& entry : byType) {
+            all.count += entry.second.count;
+            for (int c = 0; c < CATEGORY_COUNT; c++) {
+                all.bytes[c] += entry.second.bytes[c];
+            }
+        }
+        cout << "Memory of " << all.count << " items: " << fixed << setprecision(2) << all.total() / 1e6 << " MB, plus "
+            << slotBytes / 1e6 << " MB of store slots\n\n";
+        cout << "Bytes per item" << setw(13) << "count";
+        for (const char* heading : headings) {
+            cout << setw(8) << heading;
+        }
+        cout << setw(8) << "total" << setw(10) << "MB" << "\n";
+        for (const auto& entry : byType) {
+            displayRow(entry.first, entry.second);
+        }
+        displayRow("All items", all);
+        cout << "\nother = deadline and interval strings, links = sub-goal vectors, malloc = allocator headers and rounding";
+#ifdef __linux__
+        cout << " (from malloc_usable_size)\n";
+#else
+        cout << " (estimated)\n";
+#endif
+        cout << left;
+    }
+
+private:
+    struct Usage {
+        size_t count = 0;
+        size_t bytes[CATEGORY_COUNT] = {};
+
+        size_t total() const {
+            size_t sum = 0;
+            for (size_t value : bytes) {
+                sum += value;
+            }
+            return sum;
+        }
+    };
+
+    // Heap buffer of a string; strings short enough for the inline buffer have none
+    static void addString(Usage& usage, Category category, const string& text) {
+        if (text.capacity() > string().capacity()) {
+            addBlock(usage, category, text.data(), text.capacity() + 1);
+        }
+    }
+
+    template <typename T>
+    static void addVector(Usage& usage, Category category, const vector<T>& values) {
+        if (values.capacity() > 0) {
+            addBlock(usage, category, values.data(), values.capacity() * sizeof(T));
+        }
+    }
+
+    static void addBlock(Usage& usage, Category category, const void* block, size_t requested) {
+        usage.bytes[category] += requested;
+        usage.bytes[MALLOC] += heapBlockBytes(block, requested) - requested;
+    }
+
+    void add(const Item* item) {
+        Usage& usage = byType[itemTypeName(item)];
+        usage.count++;
+        size_t objectSize = itemObjectSize(item);
+        usage.bytes[VPTR] += sizeof(void*);
+        usage.bytes[FIELDS] += objectSize - sizeof(void*);
+        usage.bytes[MALLOC] += heapBlockBytes(item, objectSize) - objectSize;
+        addString(usage, TITLE, item->title);
+        addString(usage, DESCRIPTION, item->description);
+        if (const Task* task = dynamic_cast<const Task*>(item)) {
+            addString(usage, OTHER_STRINGS, task->deadline);
+            if (const RecurringTask* recurring = dynamic_cast<const RecurringTask*>(item)) {
+                addString(usage, OTHER_STRINGS, recurring->recurrenceInterval);
+            }
+        }
+        else if (const Note* note = dynamic_cast<const Note*>(item)) {
+            addVector(usage, TAGS, note->tags);
+            for (const string& tag : note->tags) {
+                addString(usage, TAGS, tag);
+            }
+        }
+        else if (const Goal* goal = dynamic_cast<const Goal*>(item)) {
+            addVector(usage, SUB_GOALS, goal->subGoals);
+        }
+    }
+
+    static void displayRow(const string& name, const Usage& usage) {
+        cout << left << setw(20) << name << right << setw(7) << usage.count << setprecision(1);
+        for (size_t value : usage.bytes) {
+            cout << setw(8) << static_cast<double>(value) / max<size_t>(1, usage.count);
+        }
+        cout << setw(8) << static_cast<double>(usage.total()) / max<size_t>(1, usage.count) << setprecision(2) << setw(10) << usage.total() / 1e6 << "\n";
+    }
+
+    map<string, Usage> byType;
+    size_t slotBytes;
+};
+
+// Function to merge two halves of a vector sorted by task priority
+void merge(vector<Task*>& tasks, int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+   
+    // Create temp arrays
+    vector<Task*> L(n1), R(n2);
+
+    // Copy data to temp arrays L[] and R[]
+    for (int i = 0; i < n1; i++)
+        L[i] = tasks[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = tasks[mid + 1 + j];
+
+    // Merge the temp arrays back into tasks[left..right]
+    int i = 0; // Initial index of first subarray
+    int j = 0; // Initial index of second subarray
+    int k = left; // Initial index of merged subarray
+    while (i < n1 && j < n2) {
         if (L[i]->priority <= R[j]->priority) {
             tasks[k] = L[i];
             i++;
         }
-        else {
-            tasks[k] = R[j];
-            j++;
+        else {
+            tasks[k] = R[j];
+            j++;
+        }
+        k++;
+    }
+
+    // Copy the remaining elements of L[], if there are any
+    while (i < n1) {
+        tasks[k] = L[i];
+        i++;
+        k++;
+    }
+
+    // Copy the remaining elements of R[], if there are any
+    while (j < n2) {
+        tasks[k] = R[j];
+        j++;
+        k++;
+    }
+}
+
+
+// Merge sort function for sorting tasks
+void mergeSort(vector<Task*>& tasks, int left, int right) {
+    if (left >= right) {
+        return; // Recursively return if there is only one element
+    }
+    int mid = left + (right - left) / 2; // Calculate the middle point
+    mergeSort(tasks, left, mid); // Recursively sort the left half
+    mergeSort(tasks, mid + 1, right); // Recursively sort the right half
+    merge(tasks, left, mid, right); // Merge the two halves
+}
+
+// Function to merge two halves of a vector sorted by task deadline
+void mergeByDeadline(vector<Task*>& tasks, int left, int mid, int right) {
+    int n1 = mid - left + 1; // Number of elements in the first half
+    int n2 = right - mid; // Number of elements in the second half
+
+    vector<Task*> L(n1), R(n2); // Temporary arrays for left and right halves
+
+    // Copy data to temporary arrays L[] and R[]
+    for (int i = 0; i < n1; i++)
+        L[i] = tasks[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = tasks[mid + 1 + j];
+
+    int i = 0; // Initial index of first subarray
+    int j = 0; // Initial index of second subarray
+    int k = left; // Initial index of merged subarray
+    // Merge the temp arrays back into tasks[left..right]
+    while (i < n1 && j < n2) {
+        if (L[i]->deadline <= R[j]->deadline) {
+            tasks[k] = L[i++];
+        }
+        else {
+            tasks[k] = R[j++];
+        }
+        k++;
+    }
+
+    // Copy the remaining elements of L[], if any
+    while (i < n1) {
+        tasks[k++] = L[i++];
+    }
+    // Copy the remaining elements of R[], if any
+    while (j < n2) {
+        tasks[k++] = R[j++];
+    }
+}
+
+// Function to sort tasks by their deadlines using merge sort
+void mergeSortByDeadline(vector<Task*>& tasks, int left, int right) {
+    if (left >= right) return; // Base case for recursion
+    int mid = left + (right - left) / 2;
+    mergeSortByDeadline(tasks, left, mid); // Sort the first half
+    mergeSortByDeadline(tasks, mid + 1, right); // Sort the second half
+    mergeByDeadline(tasks, left, mid, right); // Merge the two halves
+}
+
+// Function to display all items in the inventory
+void displayAllItems(const ItemStore& store) {
+    TIME_OPERATION("display all items");
+    for (auto& item : store.snapshot()) {
+        item->display(); // Call the display function polymorphically
+        cout << endl;
+    }
+}
+
+// Prints p50/p99/max of every operation timed so far in this session, and its allocations and
+// performance counters when --track-allocations or --perf-counters is on
+void showLatencyStats() {
+#if GTN_LATENCY_STATS
+    cout << "\tLatency per operation this session:\n" << endl;
+    latencyStats().display();
+#else
+    cout << "Latency statistics were compiled out (GTN_LATENCY_STATS=0)." << endl;
+#endif
+#if GTN_ALLOCATION_TRACKING
+    if (allocationTrackingUsers.load() > 0) {
+        cout << "\n\tHeap allocations per operation (since tracking started):\n" << endl;
+        allocationStats().display();
+    }
+#endif
+    if (perfProfiling.load()) {
+        cout << "\n\tPerformance counters per operation (of the calling thread; work handed to pipeline workers is not included):\n" << endl;
+        perfStats().display();
+    }
+}
+
+// Writes the spans recorded so far as Chrome trace JSON
+bool exportTrace(const string& filename) {
+#if GTN_TRACING
+    bool written = traceRegistry().writeChromeTrace(filename);
+    cout << (written ? "Trace written to " : "Could not write ") << filename << (written ? " (open it in ui.perfetto.dev or chrome://tracing)" : "") << endl;
+    return written;
+#else
+    (void)filename;
+    cout << "Tracing was compiled out (GTN_TRACING=0)." << endl;
+    return false;
+#endif
+}
+
+// Prints the reminders that became due since the last call
+void showReminders(DeadlineWheel& wheel) {
+    int today = currentDay();
+    for (const ReminderEvent& event : wheel.advance(today)) {
+        cout << "Reminder: " << event.task->title << " is due " << (event.due == today ? string("today") : "on " + formatDate(event.due)) << "\n";
+    }
+}
+
+// Prints the results of a date-range query
+void displayDueItems(const vector<DueItem>& items) {
+    if (items.empty()) {
+        cout << "No tasks found.\n";
+    }
+    for (const DueItem& item : items) {
+        cout << formatDate(item.due) << "  ";
+        item.task->display();
+    }
+}
+
+// Set while a password is read, so a session recorder (--record) logs a marker instead of the input
+bool readingSecretInput = false;
+
+// Reads a line that must not be recorded, such as a note password
+string readSecretLine() {
+    readingSecretInput = true;
+    string line;
+    getline(cin, line);
+    readingSecretInput = false;
+    return line;
+}
+
+// Function to handle tasks submenu
+void handleTasks(ItemStore& store, const DueDateIndex& dueDates) {
+    int taskChoice;
+    do {
+        cout << "-----------------------------------------\n\n";
+        cout << "\tTasks Menu\n\n";
+        cout << "1. Display All Tasks\n";
+        cout << "2. View Generic Tasks Details\n";
+        cout << "3. View Recurring Tasks Details\n";
+        cout << "4. View One-Time Tasks Details\n";
+        cout << "5. Sort tasks by priority\n";
+        cout << "6. Sort Tasks by deadline\n";
+        cout << "7. Tasks due this week\n";
+        cout << "8. Overdue tasks\n";
+        cout << "9. Tasks due between two dates\n";
+        cout << "10. Go Back\n\n";
+        cout << "-----------------------------------------\n";
+
+        if (!(cin >> taskChoice)) {
+            if (cin.eof()) {
+                return; // End of input
+            }
+            cin.clear(); // Clears error state of the stream
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignores incorrect input up to the maximum limit
+            cout << "Invalid input. Please enter a number.\n";
+            continue; // Continue to the next iteration of the loop
+        }
+
+        vector<Task*> tasks = store.snapshotOf<Task>();
+
+        switch (taskChoice) {
+        case 1: {
+            TIME_OPERATION("tasks: display all");
+            cout << "All Tasks:\n\n";
+            for (auto& task : tasks) {// Displays all tasks 
+                task->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 2: {
+            TIME_OPERATION("tasks: generic details");
+            cout << "\tGeneric Tasks Details:\n\n";
+            for (auto& task : tasks) { //Goes through and shows all generic task details
+                if (task != nullptr && dynamic_cast<RecurringTask*>(task) == nullptr && dynamic_cast<OneTimeTask*>(task) == nullptr) {
+                    cout << task->getDetails() << endl << endl;
+                }
+                else if (task == nullptr) {
+                    cout << "Error: Encountered a null task pointer." << endl;
+                }
+            }
+            break;
+        }
+        case 3: {
+            TIME_OPERATION("tasks: recurring details");
+            cout << "\tAll Recurring Tasks Details:\n" << endl;
+            for (auto& task : tasks) {//Goes through and shows all Recurring task details
+                if (RecurringTask* recurringTask = dynamic_cast<RecurringTask*>(task)) {
+                    cout << recurringTask->getDetails() << endl << endl;
+                }
+            }
+            break;
+        }
+        case 4: {
+            TIME_OPERATION("tasks: one-time details");
+            cout << "\tAll One-Time Tasks Details:\n" << endl;
+            for (auto& task : tasks) {//Goes through and shows all Non-Recurring task details
+                if (OneTimeTask* oneTimeTask = dynamic_cast<OneTimeTask*>(task)) {
+                    cout << oneTimeTask->getDetails() << endl << endl;
+                }
+            }
+            break;
+        }
+        case 5: {
+            TIME_OPERATION("tasks: sort by priority");
+            {
+                TIME_OPERATION("mergeSort");
+                mergeSort(tasks, 0, tasks.size() - 1);
+            }
+            cout << "\tTasks sorted by priority:\n" << endl;
+            for (auto& task : tasks) {
+                task->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 6: {
+            TIME_OPERATION("tasks: sort by deadline");
+            {
+                TIME_OPERATION("mergeSortByDeadline");
+                mergeSortByDeadline(tasks, 0, tasks.size() - 1);
+            }
+            cout << "\tTasks sorted by deadline:\n" << endl;
+            for (auto& task : tasks) {
+                task->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 7: {
+            TIME_OPERATION("tasks: due this week");
+            int today = currentDay();
+            int monday = today - (today + 3) % 7; // 1970-01-01 was a Thursday
+            cout << "\tTasks due this week (" << formatDate(monday) << " to " << formatDate(monday + 6) << "):\n" << endl;
+            displayDueItems(dueDates.query(monday, monday + 6));
+            break;
+        }
+        case 8: {
+            TIME_OPERATION("tasks: overdue");
+            cout << "\tOverdue tasks:\n" << endl;
+            displayDueItems(dueDates.overdue(currentDay()));
+            break;
+        }
+        case 9: {
+            string fromText, toText;
+            int from = DueDateIndex::OPEN_START, to = DueDateIndex::OPEN_END;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear the newline left by cin >>
+            cout << "Enter start date (YYYY-MM-DD, or leave empty for no start): ";
+            getline(cin, fromText);
+            cout << "Enter end date (YYYY-MM-DD, or leave empty for no end): ";
+            getline(cin, toText);
+            if ((!fromText.empty() && !parseDate(fromText, from)) || (!toText.empty() && !parseDate(toText, to))) {
+                cout << "Invalid date. Press ENTER to continue." << endl;
+                break;
+            }
+            TIME_OPERATION("tasks: due between dates"); // After the dates were entered
+            displayDueItems(dueDates.query(from, to));
+            cout << "Press ENTER to continue." << endl;
+            break;
+        }
+        case 10:
+            return; // Exit the task menu
+        default:
+            cout << "Invalid choice, please choose again." << endl;
+            break;
+        }
+        // Clears any extraneous input.
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    } while (taskChoice != 10);
+}
+
+// Heapify function for HeapSort adjusted for goals
+void heapify(vector<Goal*>& goals, int n, int i) {
+    int largest = i;  // Initialize largest as root
+    int left = 2 * i + 1;  // Left child index
+    int right = 2 * i + 2; // Right child index
+
+    // Check if left child exists and is greater than root
+    if (left < n && goals[left]->getProgress() > goals[largest]->getProgress() && goals[left]->getProgress() != -1)
+        largest = left;
+
+    // Check if right child exists and is greater than the current largest
+    if (right < n && goals[right]->getProgress() > goals[largest]->getProgress() && goals[right]->getProgress() != -1)
+        largest = right;
+
+    // If largest is not root, swap and continue heapifying
+    if (largest != i) {
+        swap(goals[i], goals[largest]);
+        heapify(goals, n, largest);
+    }
+}
+
+// HeapSort function to sort goals by progress
+void heapSort(vector<Goal*>& goals) {
+    int n = goals.size();
+
+    // Build heap from the array
+    for (int i = n / 2 - 1; i >= 0; i--)
+        heapify(goals, n, i);
+
+    // Extract elements one by one from the heap
+    for (int i = n - 1; i >= 0; i--) {
+        // Move current root to end
+        swap(goals[0], goals[i]);
+
+        // Call heapify on the reduced heap
+        heapify(goals, i, 0);
+    }
+}
+
+void handleGoals(ItemStore& store, ProgressHistory& history, GoalTree& goalTree) {
+    int goalChoice;
+    do {
+        cout << "-----------------------------------------\n";
+        cout << "\tGoals Menu\n\n";
+        cout << "1. Display All Goals\n";
+        cout << "2. View Generic Goals Details\n";
+        cout << "3. View Quantifiable Goals Details\n";
+        cout << "4. View Non-Quantifiable Goals Details\n";
+        cout << "5. Sort goals by progress\n";
+        cout << "6. Update goal progress\n";
+        cout << "7. Weekly progress history\n";
+        cout << "8. Make a goal a sub-goal\n";
+        cout << "9. Show goal hierarchy\n";
+        cout << "10. Go Back\n";
+        cout << "-----------------------------------------\n";
+
+        if (!(cin >> goalChoice)) {
+            if (cin.eof()) {
+                return; // End of input
+            }
+            cin.clear(); // Clear error state
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
+            cout << "Invalid input. Please enter a number.\n";
+            continue;
+        }
+
+        vector<Goal*> allGoals = store.snapshotOf<Goal>();
+
+        switch (goalChoice) {
+        case 1: {
+            TIME_OPERATION("goals: display all");
+            cout << "\tAll Goals:\n" << endl;
+            for (auto& goal : allGoals) {
+                goal->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 2: {
+            TIME_OPERATION("goals: generic details");
+            cout << "\tGeneric Goals Details:\n\n";
+            for (auto& goal : allGoals) {
+                if (goal != nullptr) {
+                    QuantifiableGoal* quantGoal = dynamic_cast<QuantifiableGoal*>(goal);
+                    NonQuantifiableGoal* nonQuantGoal = dynamic_cast<NonQuantifiableGoal*>(goal);
+                    if (!quantGoal && !nonQuantGoal) {
+                        cout << goal->getDetails() << endl << endl;
+                    }
+                }
+                else {
+                    cout << "Error: Encountered a null goal pointer." << endl;
+                }
+            }
+            break;
+        }
+        case 3: {
+            TIME_OPERATION("goals: quantifiable details");
+            cout << "\tQuantifiable Goals Details:\n" << endl;
+            for (auto& goal : allGoals) {
+                QuantifiableGoal* quantGoal = dynamic_cast<QuantifiableGoal*>(goal);
+                if (quantGoal) {
+                    cout << quantGoal->getDetails() << endl << endl;
+                }
+            }
+            break;
+        }
+        case 4: {
+            TIME_OPERATION("goals: non-quantifiable details");
+            cout << "\tNon-Quantifiable Goals Details:\n" << endl;
+            for (auto& goal : allGoals) {
+                if (goal->getProgress() == -1) {
+                    cout << goal->getDetails() << endl << endl;
+                }
+            }
+            break;
+        }
+        case 5: {
+            TIME_OPERATION("goals: sort by progress");
+            {
+                TIME_OPERATION("heapSort");
+                heapSort(allGoals);
+            }
+            cout << "\tGoals sorted by progress:\n" << endl;
+            for (auto& goal : allGoals) {
+                goal->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 6:
+        case 7: {
+            vector<Goal*> quantified;
+            for (auto& goal : allGoals) {
+                if (goal->getProgress() != -1) {
+                    quantified.push_back(goal);
+                    cout << quantified.size() << ". ";
+                    goal->display();
+                }
+            }
+            size_t number;
+            cout << "Enter goal number: ";
+            if (!(cin >> number) || number < 1 || number > quantified.size()) {
+                cin.clear();
+                cout << "Invalid goal number. Press ENTER to continue." << endl;
+                break;
+            }
+            Goal* goal = quantified[number - 1];
+            if (goalChoice == 6) {
+                double percent;
+                cout << "Enter new progress (0-100): ";
+                if (!(cin >> percent) || percent < 0 || percent > 100) {
+                    cin.clear();
+                    cout << "Invalid progress. Press ENTER to continue." << endl;
+                    break;
+                }
+                TIME_OPERATION("goals: update progress");
+                store.update(goal, [&]() { goalTree.setProgress(goal, percent / 100); });
+                history.record(goal->id, time(nullptr), percent / 100);
+                cout << "Progress updated! Press ENTER to continue!\n";
+            }
+            else {
+                TIME_OPERATION("goals: weekly history");
+                int today = currentDay();
+                vector<WeeklyProgress> weeks = history.weekly(goal->id, today - 7 * 25, today);
+                cout << "\tWeekly progress of " << goal->title << " (last 26 weeks):\n" << endl;
+                if (weeks.empty()) {
+                    cout << "No progress updates recorded yet.\n";
+                }
+                for (const WeeklyProgress& week : weeks) {
+                    cout << "Week of " << formatDate(week.weekStart) << ": " << fixed << setprecision(0) << week.progress * 100 << "% ("
+                        << week.updates << (week.updates == 1 ? " update)\n" : " updates)\n");
+                }
+                cout << "Press ENTER to continue." << endl;
+            }
+            break;
+        }
+        case 8: {
+            for (size_t i = 0; i < allGoals.size(); i++) {
+                cout << i + 1 << ". ";
+                allGoals[i]->display();
+            }
+            size_t childNumber, parentNumber;
+            double weight;
+            cout << "Enter sub-goal number: ";
+            if (!(cin >> childNumber) || childNumber < 1 || childNumber > allGoals.size()) {
+                cin.clear();
+                cout << "Invalid goal number. Press ENTER to continue." << endl;
+                break;
+            }
+            cout << "Enter parent goal number (0 to make it a top-level goal): ";
+            if (!(cin >> parentNumber) || parentNumber > allGoals.size()) {
+                cin.clear();
+                cout << "Invalid goal number. Press ENTER to continue." << endl;
+                break;
+            }
+            Goal* child = allGoals[childNumber - 1];
+            if (parentNumber == 0) {
+                TIME_OPERATION("goals: unlink sub-goal");
+                store.update(child, [&]() { goalTree.unlink(child); });
+                cout << child->title << " is now a top-level goal. Press ENTER to continue!\n";
+                break;
+            }
+            cout << "Enter weight of the sub-goal (e.g. 1): ";
+            if (!(cin >> weight) || weight <= 0) {
+                cin.clear();
+                cout << "Invalid weight. Press ENTER to continue." << endl;
+                break;
+            }
+            TIME_OPERATION("goals: link sub-goal");
+            Goal* parent = allGoals[parentNumber - 1];
+            bool linked = false;
+            store.update(child, [&]() { linked = goalTree.link(child, parent, weight); });
+            if (linked) {
+                cout << child->title << " is now a sub-goal of " << parent->title << ". Press ENTER to continue!\n";
+            }
+            else {
+                cout << "A goal cannot be a sub-goal of itself or of its own sub-goals. Press ENTER to continue." << endl;
+            }
+            break;
+        }
+        case 9: {
+            TIME_OPERATION("goals: show hierarchy");
+            cout << "\tGoal hierarchy (progress rolled up from sub-goals):\n" << endl;
+            goalTree.display(allGoals);
+            break;
+        }
+        case 10:
+            return;  // Exit the loop
+        default:
+            cout << "Invalid choice, please choose again." << endl;
+        }
+        // Clear the buffer to handle any extraneous input.
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    } while (goalChoice != 10);
+}
+
+
+// Checks if the tag exists in the note's tags vector.
+bool noteHasTag(const Note* note, const string& tag) {
+    return find(note->tags.begin(), note->tags.end(), tag) != note->tags.end();
+}
+
+// Helper function to search for notes by a specific tag.
+void searchNotesByTag(const vector<Note*>& notes, const string& tag) {
+    TIME_OPERATION("notes: search by tag");
+    bool found = false;
+    for (auto note : notes) {
+        if (noteHasTag(note, tag)) {
+            note->display(); // Display the note if the tag is found.
+            cout << endl;
+            found = true;
+        }
+    }
+    // If no note with the tag is found, print a message indicating so.
+    if (!found) {
+        cout << "No notes found with that tag." << endl;
+    }
+}
+
+// Helper function to compute the partial match table 
+vector<int> computeKMPTable(const string& pattern) {
+    int m = pattern.size(); // The length of the pattern
+    vector<int> lps(m, 0); // Longest prefix which is also suffix
+    int len = 0; // length of the previous longest prefix suffix
+    int i = 1; // index for which we are computing the lps value
+
+    // Loop to fill lps array
+    while (i < m) {
+        if (pattern[i] == pattern[len]) {
+            lps[i++] = ++len;
+        }
+        else if (len) {
+            len = lps[len - 1];
+        }
+        else {
+            lps[i++] = 0;
+        }
+    }
+    return lps;
+}
+
+// Function to search a text for a given pattern using the KMP searching algorithm.
+bool KMPSearch(const string& text, const string& pattern) {
+    if (pattern.empty()) return false; // Handle the edge case where pattern is an empty string.
+
+    int n = text.size(); // The length of the text to search within.
+    int m = pattern.size(); // The length of the pattern to search for.
+    int i = 0; // Index for text.
+    int j = 0; // Index for pattern.
+
+    vector<int> lps = computeKMPTable(pattern); // Preprocess the pattern to create the lps array.
+
+    // Loop through the text to find the pattern.
+    while (i < n) {
+        if (text[i] == pattern[j]) {
+            if (++j == m) {
+                return true; // Match found when we reach the end of the pattern.
+            }
+            i++;
+        }
+        else if (j) {
+            j = lps[j - 1]; // Use lps array to avoid unnecessary comparisons.
+        }
+        else {
+            i++;
+        }
+    }
+    return false; // Return false if no match is found.
+}
+
+
+// Utility to convert string to lower case
+string toLowerCase(const string& str) {
+    string lowerCaseStr;
+    transform(str.begin(), str.end(), back_inserter(lowerCaseStr),
+        [](unsigned char c) { return tolower(c); });
+    return lowerCaseStr;
+}
+
+// Case-insensitive check whether the text occurs in the note's title, description or tags
+bool noteMatchesText(const Note* note, const string& searchText) {
+    bool isProtected = dynamic_cast<const ProtectedNote*>(note) != nullptr; // Its description is ciphertext
+    string fullText = note->title + " " + (isProtected ? string() : note->description) + " ";
+    for (const auto& tag : note->tags) {
+        fullText += tag + " ";
+    }
+
+    // Convert fullText and searchText to lowercase before searching
+    return KMPSearch(toLowerCase(fullText), toLowerCase(searchText));
+}
+
+// Full text search across all note fields
+void searchNotesFullText(const vector<Note*>& notes, const string& searchText) {
+    TIME_OPERATION("notes: full-text search");
+    bool found = false;
+    cout << "\nSearching all note fields for: " << searchText << "\n\n " << endl;
+    for (const auto& note : notes) {
+        if (noteMatchesText(note, searchText)) {
+            note->display();
+            cout << endl;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        cout << "No matching notes found." << endl;
+    }
+}
+
+void handleNotes(ItemStore& store) {
+    int noteChoice;
+    do {
+        cout << "-----------------------------------------\n";
+        cout << "\tNotes Menu\n\n";
+        cout << "1. Display All Notes\n";
+        cout << "2. View Generic Notes Details\n";
+        cout << "3. View Protected Notes Details\n";
+        cout << "4. View Unprotected Notes Details\n";
+        cout << "5. Search for a note (full text)\n";
+        cout << "6. Search note by tags\n";
+        cout << "7. Go Back\n";
+        cout << "-----------------------------------------\n";
+
+        if (!(cin >> noteChoice)) {
+            if (cin.eof()) {
+                return; // End of input
+            }
+            cin.clear(); // Clear error state
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard bad input
+            cout << "Invalid input. Please enter a number.\n";
+            continue;
+        }
+
+        vector<Note*> notes = store.snapshotOf<Note>();
+
+        switch (noteChoice) {
+        case 1: {
+            TIME_OPERATION("notes: display all");
+            cout << "All Notes:\n\n";
+            for (auto& note : notes) {
+                note->display();
+                cout << endl;
+            }
+            break;
+        }
+        case 2: { // Now this will only display details for generic notes
+            TIME_OPERATION("notes: generic details");
+            cout << "\tGeneric Notes Details:\n\n";
+            for (auto& note : notes) {
+                if (note != nullptr && dynamic_cast<ProtectedNote*>(note) == nullptr && dynamic_cast<PublicNote*>(note) == nullptr) {
+                    cout << note->getDetails() << endl << endl;
+                }
+                else if (note == nullptr) {
+                    cout << "Note is null and cannot be displayed.\n";
+                }
+            }
+            break;
+        }
+        case 3: {
+            cout << "\tProtected Notes Details:\n\n";
+            bool accessGranted = false;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer just in case
+
+            for (auto& note : notes) {
+                ProtectedNote* protectedNote = dynamic_cast<ProtectedNote*>(note);
+                if (protectedNote) {
+                    cout << "\nEnter password to view " << protectedNote->title << "(HINT: password123 for Personal Diary, if you want to access other protected notes you've created please press ENTER): ";
+                    string passwordInput = readSecretLine();
+
+                    string details;
+                    bool unlocked;
+                    {
+                        TIME_OPERATION("notes: unlock protected note"); // Key derivation and decryption
+                        unlocked = protectedNote->unlock(passwordInput, details);
+                    }
+                    if (unlocked) { // Only decrypted once access is granted
+                        cout << "\nAccess granted to: " << protectedNote->title << "\n";
+                        cout << details << endl << endl;
+                        accessGranted = true;
+                        break;
+                    }
+                    else {
+                        cout << "Incorrect password. Try again for this note.\n";
+                    }
+                }
+            }
+
+            if (!accessGranted) {
+                cout << "\nNo access granted to any protected notes with given passwords.\n";
+            }
+            break;
+        }
+        case 4: {
+            TIME_OPERATION("notes: unprotected details");
+            cout << "\tUnprotected Notes Details:\n\n";
+            for (auto& note : notes) {
+                if (PublicNote* publicNote = dynamic_cast<PublicNote*>(note)) {
+                    cout << publicNote->getDetails() << endl << endl;
+                }
+            }
+            break;
+        }
+        case 5:
+        {
+            string searchText;
+            cout << "\nEnter search text: ";
+            cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            getline(cin, searchText);
+            searchNotesFullText(notes, searchText);
+        }
+        break;
+        case 6:
+        {
+            string tag;
+            cout << "\nEnter tag to search: ";
+            cin >> tag;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear any excess input
+            searchNotesByTag(notes, tag);
+        }
+        break;
+        case 7:
+            return; // Exit the loop and return to the main menu
+        default:
+            cout << "Invalid choice, please choose again.\n";
+        }
+    } while (noteChoice != 7); // Keep looping until 'Go Back' is selected
+}
+
+void addTask(ItemStore& store) {
+    string title, description, deadline, interval;
+    int priority, type;
+    cout << "Enter task type (1 for One-Time, 2 for Recurring, 3 for Generic): ";
+    if (!(cin >> type)) {
+        cin.clear(); // Clear error state
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
+        cout << "Invalid input. Please enter a valid number. Press ENTER to continue." << endl;
+        return; // Exit the function on invalid input
+    }
+    cin.ignore(); // Clear the newline left by cin >>
+
+    cout << "Enter task title: ";
+    getline(cin, title);
+    cout << "Enter description: ";
+    getline(cin, description);
+    cout << "Enter deadline (YYYY-MM-DD or No Deadline): ";
+    getline(cin, deadline);
+    cout << "Enter priority (1-10): ";
+    if (!(cin >> priority)) {
+        cin.clear(); // Clear error state
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
+        cout << "Invalid input. Please enter a valid number. Press ENTER to continue." << endl;
+        return; // Exit the function on invalid input
+    }
+    cin.ignore(); // Clear the newline left by cin >>
+
+    if (type == 2) { // Recurring Task
+        cout << "Enter recurrence interval (e.g., weekly, monthly): ";
+        getline(cin, interval);
+        TIME_OPERATION("add task");
+        RecurringTask* newTask = new RecurringTask(title, description, deadline, priority, interval);
+        store.add(newTask);
+        cout << "Recurring Task added successfully! Press ENTER to continue!\n";
+    }
+    else if (type == 1) { // One-Time Task
+        TIME_OPERATION("add task");
+        OneTimeTask* newTask = new OneTimeTask(title, description, deadline, priority);
+        store.add(newTask);
+        cout << "One-Time Task added successfully! Press ENTER to continue!\n";
+    }
+    else { // Generic Task
+        TIME_OPERATION("add task");
+        Task* newTask = new Task(title, description, deadline, priority);
+        store.add(newTask);
+        cout << "Generic Task added successfully! Press ENTER to continue!\n";
+    }
+}
+
+
+
+
+
+void addGoal(ItemStore& store) {
+    string title, description;
+    double progress = 0.0; // Initialize progress with a default value
+    int type;
+    cout << "Enter goal type (1 for Quantifiable, 2 for Non-Quantifiable, 3 for Generic): ";
+    cin >> type;
+    cin.ignore(); // Consume the remaining newline character
+
+    cout << "Enter goal title: ";
+    getline(cin, title);
+    cout << "Enter description: ";
+    getline(cin, description);
+
+    if (type == 1) { // Quantifiable Goal
+        cout << "Enter progress (0.0 - 1.0): ";
+        cin >> progress;
+        TIME_OPERATION("add goal");
+        QuantifiableGoal* newGoal = new QuantifiableGoal(title, description, progress);
+        store.add(newGoal);
+        cout << "Quantifiable Goal added successfully!" << endl;
+    }
+    else if (type == 2) { // Non-Quantifiable Goal
+        TIME_OPERATION("add goal");
+        NonQuantifiableGoal* newGoal = new NonQuantifiableGoal(title, description, progress); // Default progress as 0
+        store.add(newGoal);
+        cout << "Non-Quantifiable Goal added successfully! Press ENTER to continue!" << endl;
+    }
+    else { // Generic Goal
+        cout << "Enter progress (0.0 - 1.0, enter 0 if progress does not apply): ";
+        cin >> progress;
+        TIME_OPERATION("add goal");
+        Goal* newGoal = new Goal(title, description, progress);
+        store.add(newGoal);
+        cout << "Generic Goal added successfully!" << endl;
+    }
+}
+
+
+
+
+void addNote(ItemStore& store) {
+    string title, description, tagsInput, password;
+    vector<string> tags;
+    int type;
+    cout << "Enter note type (1 for Public, 2 for Protected, 3 for Generic): ";
+    cin >> type;
+    cin.ignore(); // Important to consume the newline character after cin
+
+    cout << "Enter note title: ";
+    getline(cin, title);
+    cout << "Enter description: ";
+    getline(cin, description);
+    cout << "Enter tags (comma-separated): ";
+    getline(cin, tagsInput);
+
+    stringstream ss(tagsInput);
+    string tag;
+    while (getline(ss, tag, ',')) {
+        tag = tag.empty() ? "generic" : tag; // Ensure no empty tags; use 'generic' as a placeholder if empty
+        tags.push_back(tag);
+    }
+    if (type == 2) { // Protected Note
+        cout << "Enter password for protected note: ";
+        password = readSecretLine();
+        TIME_OPERATION("add note"); // Includes sealing the body
+        ProtectedNote* newNote = new ProtectedNote(title, description, tags, password);
+        store.add(newNote);
+        cout << "Protected Note added successfully! Press ENTER to continue!" << endl;
+    }
+    else if (type == 1) { // Public Note
+        TIME_OPERATION("add note");
+        PublicNote* newNote = new PublicNote(title, description, tags);
+        store.add(newNote);
+        cout << "Public Note added successfully! Press ENTER to continue!" << endl;
+    }
+    else if (type == 3) { // Generic Note
+        TIME_OPERATION("add note");
+        Note* newNote = new Note(title, description, tags); // Generic notes can use the base class Note
+        store.add(newNote);
+        cout << "Generic Note added successfully! Press ENTER to continue!" << endl;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+// Benchmarks and batch (command-line) commands
+// ---------------------------------------------------------------------------
+
+// Generates a reproducible mix of all nine item types for benchmarks and stress tests
+vector<Item*> generateSampleItems(size_t count, unsigned seed) {
+    static const char* const words[] = { "project", "meeting", "report", "gym", "shopping", "study", "family", "travel" };
+    const size_t wordCount = sizeof(words) / sizeof(words[0]);
+    mt19937 rng(seed);
+    vector<Item*> items;
+    items.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        string title = string(words[rng() % wordCount]) + " " + to_string(i);
+        string description = "Generated " + string(words[rng() % wordCount]) + " item";
+        char deadline[11];
+        snprintf(deadline, sizeof(deadline), "%04u-%02u-%02u", 2024 + static_cast<unsigned>(rng() % 3), 1 + static_cast<unsigned>(rng() % 12), 1 + static_cast<unsigned>(rng() % 28));
+        int priority = 1 + static_cast<int>(rng() % 10);
+        double progress = (rng() % 101) / 100.0;
+        vector<string> tags(1, words[rng() % wordCount]);
+        switch (i % 9) {
+        case 0: items.push_back(new Task(title, description, deadline, priority)); break;
+        case 1: items.push_back(new RecurringTask(title, description, deadline, priority, (rng() % 2) ? "Weekly" : "Daily")); break;
+        case 2: items.push_back(new OneTimeTask(title, description, deadline, priority)); break;
+        case 3: items.push_back(new Note(title, description, tags)); break;
+        case 4: items.push_back(new ProtectedNote(title, description, tags, "password" + to_string(i % 8))); break; // Few passwords: one key derivation each
+        case 5: items.push_back(new PublicNote(title, description, tags)); break;
+        case 6: items.push_back(new Goal(title, description, progress)); break;
+        case 7: items.push_back(new QuantifiableGoal(title, description, progress)); break;
+        default: items.push_back(new NonQuantifiableGoal(title, description, 0)); break;
+        }
+    }
+    return items;
+}
+
+// Stress test for ItemStore: writers add items while readers take snapshots.
+// Checks that every snapshot is strictly ordered by ID and that no item is lost or duplicated.
+bool stressItemStore(int writerCount, int readerCount, int addsPerWriter) {
+    ItemStore store;
+    atomic<bool> writersDone(false);
+    atomic<bool> failed(false);
+    atomic<unsigned> nextSeed(1);
+
+    vector<thread> threads;
+    for (int w = 0; w < writerCount; w++) {
+        threads.emplace_back([&]() {
+            vector<Item*> items = generateSampleItems(addsPerWriter, nextSeed++);
+            for (Item* item : items) {
+                store.add(item);
+            }
+        });
+    }
+    for (int r = 0; r < readerCount; r++) {
+        threads.emplace_back([&]() {
+            size_t lastSize = 0;
+            while (!writersDone && !failed) {
+                vector<Item*> snapshot = store.snapshot();
+                for (size_t i = 1; i < snapshot.size(); i++) {
+                    if (snapshot[i - 1]->id >= snapshot[i]->id) {
+                        failed = true;
+                    }
+                }
+                if (snapshot.size() < lastSize) {
+                    failed = true; // Items must never disappear
+                }
+                lastSize = snapshot.size();
+            }
+        });
+    }
+    for (int w = 0; w < writerCount; w++) {
+        threads[w].join();
+    }
+    writersDone = true;
+    for (size_t t = writerCount; t < threads.size(); t++) {
+        threads[t].join();
+    }
+
+    // After all writers finish the IDs must be exactly 1..N
+    vector<Item*> finalItems = store.snapshot();
+    size_t expected = static_cast<size_t>(writerCount) * addsPerWriter;
+    if (finalItems.size() != expected || store.size() != expected) {
+        failed = true;
+    }
+    for (size_t i = 0; i < finalItems.size(); i++) {
+        if (finalItems[i]->id != i + 1) {
+            failed = true;
+            break;
+        }
+    }
+    return !failed;
+}
+
+// Progress updates through ItemStore::update while another thread saves the store over and over, as
+// the background checkpointer does (alternating the sequential and pipelined savers). Every saved
+// file must load back with all goals and only progress values that were actually written.
+// Build with -fsanitize=thread to check that the savers never read an item during an update.
+bool stressCheckpoint(size_t goalCount, double seconds) {
+    const double values[] = { 0.25, 0.5, 0.75 };
+    ItemStore store;
+    vector<Item*> goals;
+    for (size_t i = 0; i < goalCount; i++) {
+        goals.push_back(new Goal("Goal " + to_string(i), "Stress goal", values[0]));
+    }
+    store.addBatch(goals);
+
+    string filename = "stress_checkpoint.txt";
+    atomic<bool> stop(false), failed(false);
+    atomic<size_t> saves(0);
+    thread saver([&]() {
+        while (!stop && !failed) {
+            bool saved = saves % 2 ? saveDataPipelined(filename, store, 2) : saveDataToFile(filename, store);
+            ItemStore loaded;
+            loadDataFromFile(filename, loaded);
+            vector<Goal*> loadedGoals = loaded.snapshotOf<Goal>();
+            if (!saved || loadedGoals.size() != goalCount) {
+                failed = true;
+            }
+            for (const Goal* goal : loadedGoals) {
+                if (find(begin(values), end(values), goal->getProgress()) == end(values)) {
+                    failed = true;
+                }
+            }
+            saves++;
+        }
+    });
+    size_t updates = 0;
+    auto start = chrono::steady_clock::now();
+    while (secondsSince(start) < seconds && !failed) {
+        Goal* goal = static_cast<Goal*>(goals[updates % goalCount]);
+        double value = values[updates % 3];
+        store.update(goal, [&]() { goal->setProgress(value); });
+        updates++;
+    }
+    stop = true;
+    saver.join();
+    remove(filename.c_str());
+    cout << "  " << updates << " progress updates during " << saves << " saves" << endl;
+    return !failed;
+}
+
+// Mixed read/write throughput of ItemStore for 1, 2, 4, ... threads up to the core count.
+// Each operation is a full-text note search, a priority sort of all tasks, or (10% of the time) an add.
+void benchmarkItemStore(size_t initialItems, double seconds) {
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    cout << "ItemStore mixed workload (" << initialItems << " initial items, " << seconds << "s per run, " << cores << " cores)\n";
+    cout << left << setw(10) << "threads" << setw(14) << "reads/s" << setw(14) << "adds/s" << "total ops/s\n" << right;
+
+    for (unsigned threadCount = 1; ; threadCount *= 2) {
+        threadCount = min(threadCount, cores);
+        ItemStore store;
+        for (Item* item : generateSampleItems(initialItems, 7)) {
+            store.add(item);
+        }
+
+        atomic<bool> stop(false);
+        atomic<size_t> reads(0), adds(0), matches(0);
+        vector<thread> threads;
+        for (unsigned t = 0; t < threadCount; t++) {
+            threads.emplace_back([&, t]() {
+                mt19937 rng(1000 + t);
+                size_t localReads = 0, localAdds = 0, localMatches = 0;
+                while (!stop) {
+                    unsigned op = rng() % 10;
+                    if (op == 0) {
+                        store.add(new Task("bench task", "added during benchmark", "2025-01-01", 1 + static_cast<int>(rng() % 10)));
+                        localAdds++;
+                    }
+                    else if (op % 2) {
+                        for (Note* note : store.snapshotOf<Note>()) {
+                            localMatches += KMPSearch(note->description, "gym");
+                        }
+                        localReads++;
+                    }
+                    else {
+                        vector<Task*> tasks = store.snapshotOf<Task>();
+                        mergeSort(tasks, 0, static_cast<int>(tasks.size()) - 1);
+                        localReads++;
+                    }
+                }
+                reads += localReads;
+                adds += localAdds;
+                matches += localMatches; // Keeps the searches observable so they are not optimized away
+            });
+        }
+        this_thread::sleep_for(chrono::duration<double>(seconds));
+        stop = true;
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        cout << left << setw(10) << threadCount << right << fixed << setprecision(1)
+            << setw(10) << reads / seconds << "    " << setw(10) << adds / seconds << "    " << (reads + adds) / seconds << "\n";
+        if (threadCount == cores) {
+            break;
+        }
+    }
+}
+
+// Server protocol: each request is one line, each response is "OK <n>" followed by n lines,
+// or a single "ERR <message>" line.
+//   PING                          -> OK 0
+//   LIST [tasks|goals|notes]      -> one record per item
+//   SORT priority|deadline|progress
+//   SEARCH <text>                 -> notes matching the text (case-insensitive)
+//   TAG <tag>                     -> notes with the tag
+//   ADD <data.txt record>         -> OK 1 followed by the new item's ID; the item is in the store
+//                                    (and in any later LIST) once the response is sent
+
+// Formats a list of items as a protocol response; protected notes never expose their contents
+template <typename T>
+string formatServerResponse(const vector<T*>& items) {
+    string response = "OK " + to_string(items.size()) + "\n";
+    for (const T* item : items) {
+        response += to_string(item->id) + "\t";
+        if (const ProtectedNote* note = dynamic_cast<const ProtectedNote*>(item)) {
+            response += "ProtectedNote," + note->title + ",[Protected]";
+        }
+        else {
+            response += item->getRecord();
+        }
+        response += "\n";
+    }
+    return response;
+}
+
+// Executes one protocol request against the store and returns the full response text.
+// With an ingestor, ADD goes through its applier and waits for the batch holding the item.
+string handleServerRequest(ItemStore& store, const string& request, ItemIngestor* ingestor = nullptr) {
+    size_t space = request.find(' ');
+    string command = request.substr(0, space);
+    string argument = space == string::npos ? "" : request.substr(space + 1);
+
+    if (command == "PING") {
+        return "OK 0\n";
+    }
+    if (command == "LIST") {
+        if (argument == "tasks") return formatServerResponse(store.snapshotOf<Task>());
+        if (argument == "goals") return formatServerResponse(store.snapshotOf<Goal>());
+        if (argument == "notes") return formatServerResponse(store.snapshotOf<Note>());
+        if (argument.empty()) return formatServerResponse(store.snapshot());
+        return "ERR unknown item kind\n";
+    }
+    if (command == "SORT") {
+        if (argument == "priority" || argument == "deadline") {
+            vector<Task*> tasks = store.snapshotOf<Task>();
+            if (argument == "priority") {
+                mergeSort(tasks, 0, static_cast<int>(tasks.size()) - 1);
+            }
+            else {
+                mergeSortByDeadline(tasks, 0, static_cast<int>(tasks.size()) - 1);
+            }
+            return formatServerResponse(tasks);
+        }
+        if (argument == "progress") {
+            vector<Goal*> goals = store.snapshotOf<Goal>();
+            heapSort(goals);
+            return formatServerResponse(goals);
+        }
+        return "ERR unknown sort key\n";
+    }
+    if (command == "SEARCH" || command == "TAG") {
+        vector<Note*> matches;
+        for (Note* note : store.snapshotOf<Note>()) {
+            if (command == "TAG" ? noteHasTag(note, argument) : noteMatchesText(note, argument)) {
+                matches.push_back(note);
+            }
+        }
+        return formatServerResponse(matches);
+    }
+    if (command == "ADD") {
+        Item* item = parseItemLine(argument);
+        if (!item) {
+            return "ERR malformed record\n";
+        }
+        return "OK 1\n" + to_string(ingestor ? ingestor->submitAndWait(item) : store.add(item)) + "\n";
+    }
+    return "ERR unknown command\n";
+}
+
+#ifdef __linux__
+// One client connection of the server event loop
+struct ServerConnection {
+    int fd;
+    string inBuffer;               // Bytes received but not yet split into requests
+    string outBuffer;              // Response bytes not yet written to the socket
+    deque<string> pendingRequests; // Complete requests waiting for their turn
+    bool busy = false;             // A request from this connection is on a worker
+    bool peerClosed = false;       // The client finished sending
+};
+
+// Serves protocol requests over a Unix domain socket until SIGINT or SIGTERM.
+// A single epoll thread does all socket I/O; requests run on a worker pool and hand their
+// responses back through an eventfd. Requests on one connection are answered in order.
+int runServer(ItemStore& store, const string& socketPath, unsigned workerCount) {
+    const uint64_t LISTEN_TAG = 0, WAKE_TAG = 1, SIGNAL_TAG = 2;
+    const size_t MAX_REQUEST_BYTES = 64 * 1024;
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cout << "Socket path is too long: " << socketPath << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    // Remove a stale socket left by a previous run, but never another kind of file (such as the
+    // data file given in the socket's place)
+    struct stat existing;
+    if (lstat(socketPath.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            cout << socketPath << " exists and is not a socket; refusing to replace it." << endl;
+            return 1;
+        }
+        unlink(socketPath.c_str());
+    }
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        cout << "Cannot listen on " << socketPath << ": " << strerror(errno) << endl;
+        if (listenFd >= 0) {
+            close(listenFd);
+        }
+        return 1;
+    }
+
+    // SIGINT/SIGTERM are delivered through a signalfd so the loop can shut down cleanly
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    int signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    int wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    auto watch = [&](int fd, uint32_t events, uint64_t tag, int op) {
+        epoll_event event;
+        event.events = events;
+        event.data.u64 = tag;
+        epoll_ctl(epollFd, op, fd, &event);
+    };
+    watch(listenFd, EPOLLIN, LISTEN_TAG, EPOLL_CTL_ADD);
+    watch(wakeFd, EPOLLIN, WAKE_TAG, EPOLL_CTL_ADD);
+    watch(signalFd, EPOLLIN, SIGNAL_TAG, EPOLL_CTL_ADD);
+
+    // Connections are keyed by a never-reused ID so late worker results cannot reach a recycled fd
+    unordered_map<uint64_t, ServerConnection> connections;
+    uint64_t nextConnectionId = 3;
+    mutex completedMutex;
+    vector<pair<uint64_t, string>> completed;
+    ItemIngestor ingestor(store); // Workers hand ADDs to the ingestion thread instead of locking shards themselves
+    unique_ptr<WorkerPool> pool(new WorkerPool(workerCount));
+
+    auto dispatchNext = [&](uint64_t id, ServerConnection& connection) {
+        if (connection.busy || connection.pendingRequests.empty()) {
+            return;
+        }
+        connection.busy = true;
+        string request = move(connection.pendingRequests.front());
+        connection.pendingRequests.pop_front();
+        pool->submit([&, id, request]() {
+            string response = handleServerRequest(store, request, &ingestor);
+            {
+                lock_guard<mutex> lock(completedMutex);
+                completed.emplace_back(id, move(response));
+            }
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        });
+    };
+
+    auto closeConnection = [&](uint64_t id) {
+        auto it = connections.find(id);
+        if (it != connections.end()) {
+            close(it->second.fd); // Closing also removes the fd from the epoll set
+            connections.erase(it);
+        }
+    };
+
+    // Writes as much buffered output as the socket accepts; returns false if the connection was closed
+    auto flush = [&](uint64_t id, ServerConnection& connection) {
+        while (!connection.outBuffer.empty()) {
+            ssize_t written = send(connection.fd, connection.outBuffer.data(), connection.outBuffer.size(), MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                closeConnection(id);
+                return false;
+            }
+            connection.outBuffer.erase(0, written);
+        }
+        if (connection.peerClosed && !connection.busy && connection.pendingRequests.empty() && connection.outBuffer.empty()) {
+            closeConnection(id);
+            return false;
+        }
+        watch(connection.fd, connection.outBuffer.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT, id, EPOLL_CTL_MOD);
+        return true;
+    };
+
+    cout << "GTN server listening on " << socketPath << " with " << workerCount << " workers (" << store.size() << " items)" << endl;
+
+    bool running = true;
+    vector<epoll_event> events(256);
+    while (running) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        for (int e = 0; e < ready; e++) {
+            uint64_t tag = events[e].data.u64;
+            if (tag == SIGNAL_TAG) {
+                running = false;
+            }
+            else if (tag == LISTEN_TAG) {
+                int clientFd;
+                while ((clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    uint64_t id = nextConnectionId++;
+                    connections[id].fd = clientFd;
+                    watch(clientFd, EPOLLIN, id, EPOLL_CTL_ADD);
+                }
+            }
+            else if (tag == WAKE_TAG) {
+                uint64_t count;
+                ssize_t ignored = read(wakeFd, &count, sizeof(count));
+                (void)ignored;
+                vector<pair<uint64_t, string>> results;
+                {
+                    lock_guard<mutex> lock(completedMutex);
+                    results.swap(completed);
+                }
+                for (auto& result : results) {
+                    auto it = connections.find(result.first);
+                    if (it == connections.end()) {
+                        continue; // Client went away while its request was running
+                    }
+                    ServerConnection& connection = it->second;
+                    connection.busy = false;
+                    connection.outBuffer += result.second;
+                    dispatchNext(result.first, connection);
+                    flush(result.first, connection);
+                }
+            }
+            else {
+                auto it = connections.find(tag);
+                if (it == connections.end()) {
+                    continue;
+                }
+                ServerConnection& connection = it->second;
+                if (events[e].events & (EPOLLERR | EPOLLHUP) && !(events[e].events & EPOLLIN)) {
+                    closeConnection(tag);
+                    continue;
+                }
+                if (events[e].events & EPOLLOUT) {
+                    if (!flush(tag, connection)) {
+                        continue;
+                    }
+                }
+                if (events[e].events & EPOLLIN) {
+                    char buffer[16 * 1024];
+                    ssize_t received;
+                    while ((received = recv(connection.fd, buffer, sizeof(buffer), 0)) > 0) {
+                        connection.inBuffer.append(buffer, received);
+                    }
+                    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        connection.peerClosed = true;
+                    }
+                    // Split complete lines into requests
+                    size_t start = 0, newline;
+                    while ((newline = connection.inBuffer.find('\n', start)) != string::npos) {
+                        string request = connection.inBuffer.substr(start, newline - start);
+                        if (!request.empty() && request.back() == '\r') {
+                            request.pop_back();
+                        }
+                        connection.pendingRequests.push_back(move(request));
+                        start = newline + 1;
+                    }
+                    connection.inBuffer.erase(0, start);
+                    if (connection.inBuffer.size() > MAX_REQUEST_BYTES) {
+                        connection.outBuffer += "ERR request too long\n";
+                        connection.inBuffer.clear();
+                        connection.peerClosed = true;
+                    }
+                    dispatchNext(tag, connection);
+                    flush(tag, connection);
+                }
+            }
+        }
+    }
+
+    cout << "GTN server shutting down" << endl;
+    for (auto& entry : connections) {
+        close(entry.second.fd);
+    }
+    close(listenFd);
+    unlink(socketPath.c_str());
+    close(epollFd);
+    close(signalFd);
+    pool.reset(); // Let in-flight requests finish before the eventfd they signal is closed
+    close(wakeFd);
+    return 0;
+}
+
+// Local load generator: each client sends requests back to back and records per-request latency
+void runLoadGenerator(const string& socketPath, unsigned clientCount, unsigned requestsPerClient) {
+    static const char* const requests[] = { "LIST tasks", "SORT priority", "SORT deadline", "SEARCH project", "TAG project", "PING" };
+    const size_t requestKinds = sizeof(requests) / sizeof(requests[0]);
+    vector<vector<double>> latencies(clientCount);
+    atomic<unsigned> failures(0);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> clients;
+    for (unsigned c = 0; c < clientCount; c++) {
+        clients.emplace_back([&, c]() {
+            int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            sockaddr_un address;
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+            if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                failures++;
+                close(fd);
+                return;
+            }
+            string buffer;
+            char chunk[16 * 1024];
+            for (unsigned r = 0; r < requestsPerClient; r++) {
+                string request = string(requests[(c + r) % requestKinds]) + "\n";
+                auto sent = chrono::steady_clock::now();
+                if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) < 0) {
+                    failures++;
+                    break;
+                }
+                // Read the "OK <n>" header, then n more lines
+                size_t linesNeeded = 1, pos = 0;
+                bool headerParsed = false, ok = true;
+                while (ok) {
+                    size_t newline;
+                    while (linesNeeded > 0 && (newline = buffer.find('\n', pos)) != string::npos) {
+                        if (!headerParsed) {
+                            headerParsed = true;
+                            ok = buffer.compare(0, 3, "OK ") == 0;
+                            linesNeeded += ok ? stoul(buffer.substr(3, newline - 3)) : 0;
+                        }
+                        pos = newline + 1;
+                        linesNeeded--;
+                    }
+                    if (linesNeeded == 0) {
+                        break;
+                    }
+                    ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+                    if (received <= 0) {
+                        ok = false;
+                        break;
+                    }
+                    buffer.append(chunk, received);
+                }
+                buffer.erase(0, pos);
+                if (!ok) {
+                    failures++;
+                    break;
+                }
+                latencies[c].push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - sent).count());
+            }
+            close(fd);
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    double elapsed = secondsSince(start);
+
+    vector<double> all;
+    for (auto& clientLatencies : latencies) {
+        all.insert(all.end(), clientLatencies.begin(), clientLatencies.end());
+    }
+    sort(all.begin(), all.end());
+    cout << "Load generator: " << clientCount << " clients, " << all.size() << " requests, " << failures << " failures\n";
+    if (!all.empty()) {
+        cout << fixed << setprecision(1)
+            << "  throughput: " << all.size() / elapsed << " requests/s\n"
+            << "  latency p50: " << all[all.size() / 2] << " us, p99: " << all[min(all.size() - 1, all.size() * 99 / 100)]
+            << " us, max: " << all.back() << " us" << endl;
+    }
+}
+#endif
+
+// Asks the OS to drop the file's cached pages so the next read comes from disk (Linux only)
+bool dropFileCache(const string& filename) {
+#ifdef __linux__
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    fdatasync(fd); // Dirty pages cannot be dropped
+    bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return dropped;
+#else
+    (void)filename;
+    return false;
+#endif
+}
+
+// Compares sequential load/save against the coroutine pipelines on a generated file
+void benchmarkLoadSave(size_t itemCount, const string& filename) {
+    unsigned threads = max(2u, thread::hardware_concurrency());
+    {
+        ItemStore generated;
+        generated.addBatch(generateSampleItems(itemCount, 11));
+        saveDataPipelined(filename, generated, threads);
+    }
+    cout << "Load/save of " << itemCount << " items, pipeline executor with " << threads << " threads\n";
+
+    size_t counts[2];
+    for (int pipelined = 0; pipelined < 2; pipelined++) {
+        bool cold = dropFileCache(filename);
+        ItemStore store;
+        auto start = chrono::steady_clock::now();
+        if (pipelined) {
+            loadDataPipelined(filename, store, threads);
+        }
+        else {
+            loadDataFromFile(filename, store);
+        }
+        double elapsed = secondsSince(start);
+        counts[pipelined] = store.size();
+        cout << fixed << setprecision(3) << "  load " << (pipelined ? "pipelined " : "sequential") << (cold ? " (cold cache): " : " (warm cache): ")
+            << elapsed << " s, " << store.size() << " items\n";
+    }
+    if (counts[0] != counts[1]) {
+        cout << "  MISMATCH: the two loaders produced different item counts\n";
+    }
+
+    ItemStore store;
+    loadDataFromFile(filename, store);
+    for (int pipelined = 0; pipelined < 2; pipelined++) {
+        auto start = chrono::steady_clock::now();
+        if (pipelined) {
+            saveDataPipelined(filename, store, threads);
+        }
+        else {
+            ofstream out(filename, ios::trunc);
+            for (Item* item : store.snapshot()) {
+                out << item->getRecord() << "\n";
+            }
+        }
+        cout << fixed << setprecision(3) << "  save " << (pipelined ? "pipelined " : "sequential") << ": " << secondsSince(start) << " s\n";
+    }
+    remove(filename.c_str());
+}
+
+// Save throughput in GB/s: the per-field ofstream approach against the buffered serializer,
+// single-threaded and pipelined, each including fsync and the atomic rename
+void benchmarkSave(size_t itemCount, const string& filename) {
+    ItemStore store;
+    store.addBatch(generateSampleItems(itemCount, 21));
+    vector<Item*> items = store.snapshot();
+    unsigned threads = max(2u, thread::hardware_concurrency());
+
+    auto start = chrono::steady_clock::now();
+    string buffer;
+    for (Item* item : items) {
+        store.appendRecord(item, buffer);
+        buffer += '\n';
+    }
+    double serializeSeconds = secondsSince(start);
+    double gigabytes = buffer.size() / 1e9;
+    cout << "Saving " << itemCount << " items (" << fixed << setprecision(1) << buffer.size() / 1e6 << " MB)\n" << setprecision(2);
+    cout << "  serialize only, 1 thread:          " << gigabytes / serializeSeconds << " GB/s\n";
+
+    start = chrono::steady_clock::now();
+    {
+        ofstream out(filename, ios::trunc);
+        for (Item* item : items) {
+            out << item->getRecord() << "\n";
+        }
+    }
+    cout << "  ofstream per record, no fsync:     " << gigabytes / secondsSince(start) << " GB/s\n";
+
+    start = chrono::steady_clock::now();
+    {
+        AtomicFileWriter file(filename);
+        string single;
+        for (Item* item : items) {
+            store.appendRecord(item, single);
+            single += '\n';
+        }
+        file.write(single.data(), single.size());
+        file.commit();
+    }
+    cout << "  buffered, 1 thread, fsync+rename:  " << gigabytes / secondsSince(start) << " GB/s\n";
+
+    start = chrono::steady_clock::now();
+    bool saved = saveDataPipelined(filename, store, threads);
+    cout << "  pipelined, " << threads << " threads, fsync+rename: " << gigabytes / secondsSince(start) << " GB/s" << (saved ? "" : " (FAILED)") << "\n";
+    remove(filename.c_str());
+}
+
+// Worst-case pause of an interactive thread (adding single items) while a background checkpoint
+// of the whole store is written, compared with the same loop without a checkpoint
+void benchmarkCheckpoint(size_t itemCount, const string& filename) {
+    ItemStore store;
+    for (size_t done = 0; done < itemCount; done += 1000000) {
+        store.addBatch(generateSampleItems(min<size_t>(1000000, itemCount - done), static_cast<unsigned>(done)));
+    }
+    cout << "Checkpoint of " << itemCount << " items\n";
+
+    for (int withCheckpoint = 0; withCheckpoint < 2; withCheckpoint++) {
+        vector<double> pauses;
+        unique_ptr<Checkpointer> checkpointer;
+        if (withCheckpoint) {
+            // Triggered by the first add below
+            checkpointer.reset(new Checkpointer(store, [&]() { return saveDataToFile(filename, store); }, 0, 1));
+        }
+        auto start = chrono::steady_clock::now();
+        // Without a checkpoint run for a fixed two seconds; with one, until it has been written
+        while (withCheckpoint ? checkpointer->checkpointsWritten() == 0 : secondsSince(start) < 2.0) {
+            auto before = chrono::steady_clock::now();
+            store.add(new Task("interactive", "added during checkpoint", "2025-01-01", 5));
+            pauses.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - before).count());
+            this_thread::sleep_for(chrono::microseconds(200)); // Think time between menu actions
+        }
+        double checkpointSeconds = withCheckpoint ? checkpointer->lastCheckpointSeconds() : 0;
+        checkpointer.reset();
+
+        sort(pauses.begin(), pauses.end());
+        cout << fixed << setprecision(3) << (withCheckpoint ? "  during checkpoint" : "  no checkpoint    ")
+            << ": " << pauses.size() << " adds, p99 " << pauses[pauses.size() * 99 / 100] << " ms, worst pause " << pauses.back() << " ms";
+        if (withCheckpoint) {
+            cout << ", checkpoint took " << checkpointSeconds << " s";
+        }
+        cout << "\n";
+    }
+    remove(filename.c_str());
+}
+
+// Cost of persisting one new note: full save of the data file against a segmented incremental save
+void benchmarkSegmentedSave(const string& directory) {
+    cout << left << setw(12) << "items" << setw(18) << "full save (ms)" << setw(24) << "incremental save (ms)" << "segments written\n" << right;
+    for (size_t itemCount = 10000; itemCount <= 1000000; itemCount *= 10) {
+        filesystem::remove_all(directory);
+        ItemStore store;
+        SegmentedStorage segments(directory);
+        segments.load(store, "");
+        store.addBatch(generateSampleItems(itemCount, 31));
+        segments.save(store); // Initial full write of every segment
+
+        store.add(new Note("New note", "one small change", vector<string>(1, "bench")));
+        auto start = chrono::steady_clock::now();
+        segments.save(store);
+        double incremental = secondsSince(start) * 1000;
+        size_t written = segments.segmentsWrittenLastSave();
+
+        start = chrono::steady_clock::now();
+        saveDataToFile(directory + "/full.txt", store);
+        double full = secondsSince(start) * 1000;
+
+        cout << left << setw(12) << itemCount << right << fixed << setprecision(2) << setw(14) << full << "    " << setw(20) << incremental << "    " << written << "\n";
+    }
+    filesystem::remove_all(directory);
+}
+
+#ifndef _WIN32
+// Startup time of the memory-mapped store against loadDataFromFile for the same items:
+// time until the store is usable, until the first screen of 20 items is shown, and for a full scan
+void benchmarkMappedStartup(size_t itemCount, const string& filename) {
+    string mappedFile = filename + ".map";
+    {
+        ItemStore generated;
+        generated.addBatch(generateSampleItems(itemCount, 51));
+        saveDataToFile(filename, generated);
+        remove(mappedFile.c_str());
+        MappedItemStore mapped;
+        mapped.open(mappedFile);
+        size_t rejected = 0;
+        for (Item* item : generated.snapshot()) {
+            rejected += mapped.append(item) == SIZE_MAX;
+        }
+        mapped.flush();
+        if (rejected) {
+            cout << rejected << " items do not fit the fixed-size records and are only in the data file." << endl;
+        }
+    }
+    cout << "Startup with " << itemCount << " items\n" << fixed << setprecision(3);
+
+    bool cold = dropFileCache(filename);
+    auto start = chrono::steady_clock::now();
+    ItemStore store;
+    loadDataFromFile(filename, store);
+    cout << "  loadDataFromFile" << (cold ? " (cold cache)" : " (warm cache)") << ": " << secondsSince(start) * 1000 << " ms until usable\n";
+
+    cold = dropFileCache(mappedFile);
+    start = chrono::steady_clock::now();
+    MappedItemStore mapped;
+    bool opened = mapped.open(mappedFile);
+    double openMs = secondsSince(start) * 1000;
+    for (size_t i = 0; i < min<size_t>(20, mapped.size()); i++) {
+        delete mapped.materialize(i);
+    }
+    double firstScreenMs = secondsSince(start) * 1000;
+    size_t valid = 0;
+    for (size_t i = 0; i < mapped.size(); i++) {
+        Item* item = mapped.materialize(i);
+        valid += item != nullptr;
+        delete item;
+    }
+    cout << "  mapped store" << (cold ? " (cold cache)" : " (warm cache)") << ":     " << openMs << " ms until usable" << (opened ? "" : " (FAILED)")
+        << ", " << firstScreenMs << " ms to the first 20 items, " << secondsSince(start) * 1000 << " ms to read all " << valid << " items\n";
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < mapped.size(); i += 9) {
+        mapped.setPriority(i, 1); // Every 9th item is a task
+    }
+    mapped.flush();
+    cout << "  in-place priority update of " << (mapped.size() + 8) / 9 << " tasks + flush: " << secondsSince(start) * 1000 << " ms\n";
+    mapped.close();
+    remove(filename.c_str());
+    remove(mappedFile.c_str());
+}
+
+// "mmap import|list|set-priority|set-progress" batch commands on a memory-mapped store file
+int runMappedCommand(const vector<string>& args) {
+    MappedItemStore mapped;
+    if (args.size() < 3 || !mapped.open(args[2])) {
+        cout << "Cannot open the mapped store." << endl;
+        return 1;
+    }
+    if (args[1] == "import") {
+        ItemStore store;
+        loadDataFromFile(args.size() >= 4 ? args[3] : "data.txt", store);
+        size_t imported = 0, failed = 0;
+        for (Item* item : store.snapshot()) {
+            string error;
+            if (mapped.append(item, &error) == SIZE_MAX) {
+                cout << "Not imported: " << item->title << " (" << error << ")" << endl;
+                failed++;
+            }
+            else {
+                imported++;
+            }
+        }
+        cout << "Imported " << imported << " of " << store.size() << " items, the mapped store now holds " << mapped.size() << "." << endl;
+        if (failed) {
+            cout << "Error: " << failed << " items could not be imported." << endl;
+            mapped.flush(); // The imported ones are kept
+            return 1;
+        }
+    }
+    else if (args[1] == "list") {
+        for (size_t i = 0; i < mapped.size(); i++) {
+            unique_ptr<Item> item(mapped.materialize(i));
+            if (item) {
+                cout << "[" << i << "] ";
+                item->display();
+            }
+            else {
+                cout << "[" << i << "] corrupt record\n";
+            }
+        }
+        return 0;
+    }
+    else if (args[1] == "set-priority" && args.size() >= 5) {
+        if (!mapped.setPriority(stoul(args[3]), stoi(args[4]))) {
+            cout << "Record " << args[3] << " is not a task." << endl;
+            return 1;
+        }
+    }
+    else if (args[1] == "set-progress" && args.size() >= 5) {
+        if (!mapped.setProgress(stoul(args[3]), stod(args[4]))) {
+            cout << "Record " << args[3] << " is not a goal." << endl;
+            return 1;
+        }
+    }
+    else {
+        cout << "Unknown mmap command." << endl;
+        return 1;
+    }
+    return mapped.flush() ? 0 : 1;
+}
+#endif
+
+// Recurrence expansion over many recurring tasks: O(1) fast-forward against stepping from the
+// first occurrence, and lazy expansion of a one-month window
+void benchmarkRecurrence(size_t taskCount) {
+    static const char* const intervals[] = { "Daily", "Weekly", "Biweekly", "Monthly", "Quarterly", "Yearly", "Every 3 days", "Every 2 months" };
+    mt19937 rng(61);
+    vector<RecurringTask*> tasks;
+    tasks.reserve(taskCount);
+    for (size_t i = 0; i < taskCount; i++) {
+        string start = formatDate(daysFromCivil(2000, 1, 1) + static_cast<int>(rng() % 9000));
+        tasks.push_back(new RecurringTask("recurring " + to_string(i), "", start, 5, intervals[rng() % 8]));
+    }
+    int target;
+    parseDate("2030-06-15", target);
+    cout << "Recurrence expansion over " << taskCount << " recurring tasks\n" << fixed << setprecision(1);
+
+    auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (RecurringTask* task : tasks) {
+        checksum += task->recurrence.nextAfter(target);
+    }
+    double fastSeconds = secondsSince(start);
+    cout << "  next occurrence after " << formatDate(target) << ", fast-forward: " << fastSeconds * 1e9 / taskCount << " ns/task\n";
+
+    // Stepping is far slower, so it runs on a sample and checks the answers agree
+    size_t sample = min<size_t>(tasks.size(), 20000);
+    size_t mismatches = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < sample; i++) {
+        const RecurrenceRule& rule = tasks[i]->recurrence;
+        long long k = 0;
+        while (rule.occurrence(k) <= target) {
+            k++;
+        }
+        mismatches += rule.occurrence(k) != rule.nextAfter(target);
+    }
+    cout << "  next occurrence after " << formatDate(target) << ", stepping:     " << secondsSince(start) * 1e9 / sample << " ns/task"
+        << (mismatches ? " (MISMATCH)" : "") << "\n";
+
+    int windowEnd;
+    parseDate("2030-06-30", windowEnd);
+    start = chrono::steady_clock::now();
+    size_t occurrences = 0;
+    for (RecurringTask* task : tasks) {
+        OccurrenceGenerator generator(task->recurrence, target, windowEnd);
+        for (int day; generator.next(day);) {
+            occurrences++;
+        }
+    }
+    double windowSeconds = secondsSince(start);
+    cout << "  lazy expansion of " << formatDate(target) << ".." << formatDate(windowEnd) << ": " << occurrences << " occurrences in "
+        << windowSeconds * 1000 << " ms (" << occurrences / windowSeconds / 1e6 << " M occurrences/s)\n";
+    cout << "  (checksum " << checksum << ")\n";
+    for (RecurringTask* task : tasks) {
+        delete task;
+    }
+}
+
+// Lists the occurrences of every recurring task in the data file between two dates
+int listOccurrences(const string& fromText, const string& toText, const string& filename) {
+    int from, to;
+    if (!parseDate(fromText, from) || !parseDate(toText, to)) {
+        cout << "Dates must be given as YYYY-MM-DD." << endl;
+        return 1;
+    }
+    ItemStore store;
+    loadDataFromFile(filename, store);
+    for (RecurringTask* task : store.snapshotOf<RecurringTask>()) {
+        cout << task->title << " (" << task->recurrenceInterval << "):";
+        if (!task->recurrence.valid()) {
+            cout << " interval not understood";
+        }
+        OccurrenceGenerator generator(task->recurrence, from, to);
+        for (int day; generator.next(day);) {
+            cout << " " << formatDate(day);
+        }
+        cout << "\n";
+    }
+    return 0;
+}
+
+// Timer wheel throughput: scheduling tasks, then advancing day by day over three years and firing
+// every reminder, compared with the cost of one polling scan over all tasks
+void benchmarkReminders(size_t taskCount) {
+    int today = currentDay();
+    mt19937 rng(71);
+    vector<Task*> tasks;
+    tasks.reserve(taskCount);
+    for (size_t i = 0; i < taskCount; i++) {
+        string deadline = formatDate(today + static_cast<int>(rng() % 1095));
+        if (i % 10 == 0) {
+            tasks.push_back(new RecurringTask("recurring " + to_string(i), "", deadline, 5, (rng() % 2) ? "Weekly" : "Monthly"));
+        }
+        else {
+            tasks.push_back(new Task("task " + to_string(i), "", deadline, 5));
+        }
+    }
+    cout << "Deadline reminders for " << taskCount << " tasks (10% recurring), lead time 1 day\n" << fixed << setprecision(1);
+
+    DeadlineWheel wheel(today, 1);
+    auto start = chrono::steady_clock::now();
+    for (Task* task : tasks) {
+        wheel.onInsert(task);
+    }
+    double insertSeconds = secondsSince(start);
+    cout << "  insert: " << insertSeconds * 1e9 / taskCount << " ns/task (" << taskCount / insertSeconds / 1e6 << " M/s)\n";
+
+    start = chrono::steady_clock::now();
+    size_t fired = 0, busiestDay = 0;
+    for (int day = today + 1; day <= today + 1095; day++) {
+        size_t count = wheel.advance(day).size();
+        fired += count;
+        busiestDay = max(busiestDay, count);
+    }
+    double fireSeconds = secondsSince(start);
+    cout << "  advance over 1095 days: " << fired << " reminders in " << fireSeconds * 1000 << " ms (" << fired / fireSeconds / 1e6
+        << " M/s, at most " << busiestDay << " on one day)\n";
+
+    start = chrono::steady_clock::now();
+    size_t dueSoon = 0;
+    for (Task* task : tasks) {
+        int due;
+        dueSoon += parseDate(task->deadline, due) && due >= today && due <= today + 1;
+    }
+    cout << "  one polling scan of all tasks: " << secondsSince(start) * 1000 << " ms (" << dueSoon << " due soon); "
+        << "polling every minute repeats it 1440 times a day\n";
+    for (Task* task : tasks) {
+        delete task;
+    }
+}
+
+// Prints the reminders the wheel fires for the tasks of a data file over the coming days
+int listReminders(const string& filename, int days, int leadDays) {
+    ItemStore store;
+    loadDataFromFile(filename, store);
+    int today = currentDay();
+    DeadlineWheel wheel(today, leadDays);
+    store.attachIndex(&wheel);
+    for (int day = today; day < today + days; day++) {
+        for (const ReminderEvent& event : wheel.advance(day)) {
+            cout << formatDate(day) << ": " << event.task->title << " is due on " << formatDate(event.due) << "\n";
+        }
+    }
+    return 0;
+}
+
+// Date-range queries on the due-date index against sorting all tasks by deadline and scanning,
+// with a brute-force check that recurring occurrences match OccurrenceGenerator
+void benchmarkDueDates(size_t taskCount) {
+    static const char* const intervals[] = { "Daily", "Weekly", "Biweekly", "Monthly", "Quarterly", "Yearly" };
+    int today = currentDay();
+    mt19937 rng(81);
+    ItemStore store;
+    DueDateIndex dueDates;
+    store.attachIndex(&dueDates);
+    vector<Item*> items;
+    for (size_t i = 0; i < taskCount; i++) {
+        string deadline = formatDate(today - 1500 + static_cast<int>(rng() % 3000));
+        if (i % 100 == 0) {
+            items.push_back(new RecurringTask("recurring " + to_string(i), "", deadline, 5, intervals[rng() % 6]));
+        }
+        else {
+            items.push_back(new Task("task " + to_string(i), "", deadline, 5));
+        }
+    }
+    auto start = chrono::steady_clock::now();
+    store.addBatch(items);
+    cout << "Due-date queries over " << taskCount << " tasks (1% recurring)\n" << fixed << setprecision(3)
+        << "  index build: " << secondsSince(start) * 1000 << " ms\n";
+
+    int monday = today - (today + 3) % 7;
+    start = chrono::steady_clock::now();
+    size_t weekCount = dueDates.query(monday, monday + 6).size();
+    cout << "  due this week (index):        " << secondsSince(start) * 1000 << " ms, " << weekCount << " results\n";
+    start = chrono::steady_clock::now();
+    size_t overdueCount = dueDates.overdue(today).size();
+    cout << "  overdue (index):              " << secondsSince(start) * 1000 << " ms, " << overdueCount << " results\n";
+    start = chrono::steady_clock::now();
+    size_t openCount = dueDates.query(today + 1000, DueDateIndex::OPEN_END).size();
+    cout << "  due after " << formatDate(today + 1000) << " (open end): " << secondsSince(start) * 1000 << " ms, " << openCount << " results\n";
+
+    start = chrono::steady_clock::now();
+    vector<Task*> tasks = store.snapshotOf<Task>();
+    mergeSortByDeadline(tasks, 0, static_cast<int>(tasks.size()) - 1);
+    size_t scanned = 0;
+    for (Task* task : tasks) {
+        int due;
+        scanned += !dynamic_cast<RecurringTask*>(task) && parseDate(task->deadline, due) && due >= monday && due <= monday + 6;
+    }
+    cout << "  due this week (sort + scan):  " << secondsSince(start) * 1000 << " ms, " << scanned << " one-off results\n";
+
+    size_t expected = 0;
+    for (Task* task : tasks) {
+        int due;
+        if (RecurringTask* recurring = dynamic_cast<RecurringTask*>(task)) {
+            OccurrenceGenerator occurrences(recurring->recurrence, monday, monday + 6);
+            for (int day; occurrences.next(day);) {
+                expected++;
+            }
+        }
+        else if (parseDate(task->deadline, due) && due >= monday && due <= monday + 6) {
+            expected++;
+        }
+    }
+    cout << "  brute-force check: " << (expected == weekCount ? "match" : "MISMATCH") << "\n";
+}
+
+// Prints the tasks due in a date range; "-" leaves that end open
+int listDueTasks(const string& fromText, const string& toText, const string& filename) {
+    int from = DueDateIndex::OPEN_START, to = DueDateIndex::OPEN_END;
+    if ((fromText != "-" && !parseDate(fromText, from)) || (toText != "-" && !parseDate(toText, to))) {
+        cout << "Dates must be given as YYYY-MM-DD or -." << endl;
+        return 1;
+    }
+    ItemStore store;
+    DueDateIndex dueDates;
+    store.attachIndex(&dueDates);
+    loadDataFromFile(filename, store);
+    displayDueItems(dueDates.query(from, to));
+    return 0;
+}
+
+// Progress history for many goals: bytes per point of the compressed series against plain
+// (time, double) pairs, range reads, and weekly downsampling over all goals
+void benchmarkProgressHistory(size_t goalCount, size_t updatesPerGoal) {
+    mt19937 rng(91);
+    ProgressHistory history;
+    int64_t yearStart = daysFromCivil(2025, 1, 1) * 86400LL;
+    auto start = chrono::steady_clock::now();
+    for (size_t goal = 1; goal <= goalCount; goal++) {
+        int64_t time = yearStart + rng() % 86400;
+        double progress = 0;
+        for (size_t i = 0; i < updatesPerGoal; i++) {
+            history.record(goal, time, progress);
+            time += 7 * 86400 + static_cast<int64_t>(rng() % 7200) - 3600; // Roughly weekly
+            progress = min(1.0, progress + (rng() % 300) / 10000.0);
+        }
+    }
+    double recordSeconds = secondsSince(start);
+    size_t points = history.pointCount();
+    size_t bytes = history.memoryBytes();
+    cout << "Progress history of " << goalCount << " goals, " << updatesPerGoal << " updates each\n" << fixed << setprecision(2)
+        << "  record: " << points / recordSeconds / 1e6 << " M points/s\n"
+        << "  memory: " << bytes / 1e6 << " MB (" << static_cast<double>(bytes) / points << " bytes/point); plain (time, double) vectors: "
+        << (points * sizeof(ProgressPoint) + goalCount * (sizeof(vector<ProgressPoint>) + sizeof(size_t))) / 1e6 << " MB\n";
+
+    int64_t quarterStart = yearStart + 180 * 86400LL, quarterEnd = quarterStart + 90 * 86400LL;
+    start = chrono::steady_clock::now();
+    size_t read = 0;
+    for (size_t goal = 1; goal <= goalCount; goal++) {
+        read += history.range(goal, quarterStart, quarterEnd).size();
+    }
+    double rangeSeconds = secondsSince(start);
+    cout << "  range read of one quarter for every goal: " << rangeSeconds * 1000 << " ms (" << read << " points)\n";
+
+    int firstDay = static_cast<int>(yearStart / 86400);
+    start = chrono::steady_clock::now();
+    size_t weeks = 0;
+    for (size_t goal = 1; goal <= goalCount; goal++) {
+        weeks += history.weekly(goal, firstDay, firstDay + 364).size();
+    }
+    double weeklySeconds = secondsSince(start);
+    cout << "  weekly downsampling of the year for every goal: " << weeklySeconds * 1000 << " ms (" << weeks << " weeks)\n";
+}
+
+// Dashboard rendering from the maintained aggregates against recomputing the figures by scanning
+// every item, plus the cost the aggregates add to inserts and updates
+void benchmarkDashboard(size_t itemCount) {
+    vector<Item*> items = generateSampleItems(itemCount, 101);
+    ItemStore plain;
+    auto start = chrono::steady_clock::now();
+    plain.addBatch(vector<Item*>(items.begin(), items.begin() + items.size() / 2));
+    double plainInsert = secondsSince(start);
+    ItemStore store;
+    DashboardAggregates dashboard;
+    store.attachIndex(&dashboard);
+    start = chrono::steady_clock::now();
+    store.addBatch(vector<Item*>(items.begin() + items.size() / 2, items.end()));
+    double indexedInsert = secondsSince(start);
+    cout << "Dashboard over " << store.size() << " items\n" << fixed << setprecision(3)
+        << "  insert without / with aggregates: " << plainInsert * 1000 << " / " << indexedInsert * 1000 << " ms\n";
+
+    streambuf* console = cout.rdbuf();
+    ostringstream discard;
+    cout.rdbuf(discard.rdbuf());
+    start = chrono::steady_clock::now();
+    dashboard.display(currentDay());
+    double renderSeconds = secondsSince(start);
+    cout.rdbuf(console);
+    cout << fixed << setprecision(3) << "  render from aggregates: " << renderSeconds * 1000 << " ms\n";
+
+    // The same figures the way they would be computed without the aggregates
+    start = chrono::steady_clock::now();
+    map<string, long long> typeCounts, tagCounts;
+    map<int, long long> priorities, deadlineWeeks;
+    map<string, pair<long long, double>> goalProgress;
+    for (Item* item : store.snapshot()) {
+        typeCounts[itemTypeName(item)]++;
+        if (Task* task = dynamic_cast<Task*>(item)) {
+            priorities[task->priority]++;
+            int due;
+            if (parseDate(task->deadline, due)) {
+                deadlineWeeks[due - (due + 3) % 7]++;
+            }
+        }
+        else if (Goal* goal = dynamic_cast<Goal*>(item)) {
+            pair<long long, double>& stats = goalProgress[itemTypeName(item)];
+            stats.first++;
+            stats.second += goal->getProgress();
+        }
+        else if (Note* note = dynamic_cast<Note*>(item)) {
+            for (const string& tag : note->tags) {
+                tagCounts[tag]++;
+            }
         }
-        k++;
     }
+    cout << "  recompute by scanning all items: " << secondsSince(start) * 1000 << " ms\n";
 
-    // Copy the remaining elements of L[], if there are any
-    while (i < n1) {
-        tasks[k] = L[i];
-        i++;
-        k++;
+    vector<Goal*> goals = store.snapshotOf<Goal>();
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < goals.size(); i++) {
+        Goal* goal = goals[i];
+        store.update(goal, [&]() { goal->setProgress((i % 101) / 100.0); });
     }
+    cout << "  goal progress update with aggregates: " << secondsSince(start) * 1e9 / max<size_t>(1, goals.size()) << " ns/update\n";
+}
 
-    // Copy the remaining elements of R[], if there are any
-    while (j < n2) {
-        tasks[k] = R[j];
-        j++;
-        k++;
+// Goal hierarchies: a wide random tree and a single deep chain. Measures linking, progress updates
+// that roll up in O(depth), the bulk roll-up when loading, and checks the incremental values
+// against a recomputation from scratch.
+void benchmarkGoalTree(size_t goalCount) {
+    mt19937 rng(111);
+    for (int deep = 0; deep < 2; deep++) {
+        ItemStore store;
+        vector<Item*> items;
+        for (size_t i = 0; i < goalCount; i++) {
+            double progress = (rng() % 101) / 100.0;
+            if (i % 10 == 9 && !deep) { // The chain is fully quantifiable so updates reach the root
+                items.push_back(new NonQuantifiableGoal("goal " + to_string(i), "", 0));
+            }
+            else {
+                items.push_back(new QuantifiableGoal("goal " + to_string(i), "", progress));
+            }
+        }
+        store.addBatch(items);
+        vector<Goal*> goals = store.snapshotOf<Goal>();
+        GoalTree tree;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 1; i < goals.size(); i++) {
+            if (deep) {
+                tree.link(goals[i - 1], goals[i], 1); // Each goal becomes the parent of the chain so far
+            }
+            else {
+                tree.link(goals[i], goals[rng() % i], 1 + rng() % 3);
+            }
+        }
+        double linkSeconds = secondsSince(start);
+        Goal* root = deep ? goals.back() : goals[0];
+        size_t depthSum = 0;
+        for (size_t i = 0; i < (deep ? 1 : 1000); i++) {
+            for (Goal* goal = goals[deep ? 0 : rng() % goals.size()]; goal->parentGoal; goal = goal->parentGoal) {
+                depthSum++;
+            }
+        }
+        cout << (deep ? "Deep chain of " : "Random tree of ") << goalCount << " goals (average depth " << depthSum / (deep ? 1 : 1000) << ")\n" << fixed << setprecision(3)
+            << "  link: " << linkSeconds * 1e9 / goalCount << " ns/goal\n";
+
+        size_t updates = deep ? 100 : 1000000;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < updates; i++) {
+            Goal* goal = goals[deep ? 0 : rng() % goals.size()];
+            tree.setProgress(goal, (rng() % 101) / 100.0);
+        }
+        cout << "  progress update with roll-up: " << secondsSince(start) * 1e6 / updates << " us/update, root now at " << tree.progressOf(root) * 100 << "%\n";
+
+        // Recompute every roll-up from scratch (children before parents) and compare
+        start = chrono::steady_clock::now();
+        vector<Goal*> order(1, root);
+        for (size_t next = 0; next < order.size(); next++) {
+            order.insert(order.end(), order[next]->subGoals.begin(), order[next]->subGoals.end());
+        }
+        unordered_map<Goal*, pair<double, double>> sums; // Weight and weighted progress of the quantifiable sub-goals
+        double worstError = 0;
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            Goal* goal = *it;
+            pair<double, double> own = sums[goal];
+            double value = own.first > 0 ? own.second / own.first : goal->getProgress();
+            worstError = max(worstError, fabs(value - goal->rolledUpProgress()));
+            if (goal->parentGoal && goal->getProgress() != -1) {
+                sums[goal->parentGoal].first += goal->weight;
+                sums[goal->parentGoal].second += goal->weight * value;
+            }
+        }
+        cout << "  full recomputation of the root: " << secondsSince(start) * 1000 << " ms, largest difference " << scientific << worstError << fixed << "\n";
+
+        tree.save("bench_goal_tree.txt", store);
+        for (Goal* goal : goals) {
+            goal->parentGoal = nullptr;
+            goal->subGoals.clear();
+            goal->childWeight = goal->childWeightedProgress = 0;
+        }
+        GoalTree loaded;
+        start = chrono::steady_clock::now();
+        loaded.load("bench_goal_tree.txt", store);
+        cout << "  load with bulk roll-up: " << secondsSince(start) * 1000 << " ms, root at " << loaded.progressOf(root) * 100 << "%\n";
+        remove("bench_goal_tree.txt");
     }
 }
 
+// Protected notes: loading sealed notes against plain notes of the same size, and the cost of the
+// first unlock of a note (key derivation) against unlocks served from the session key cache
+void benchmarkProtectedNotes(size_t noteCount, const string& filename) {
+    string body = "Meeting notes about the family trip and the shopping list";
+    string protectedFile = filename + ".protected", plainFile = filename + ".plain";
+    auto start = chrono::steady_clock::now();
+    {
+        ofstream protectedOut(protectedFile), plainOut(plainFile);
+        for (size_t i = 0; i < noteCount; i++) {
+            string title = "note " + to_string(i);
+            ProtectedNote sealed(title, body, vector<string>(1, "travel"), "password" + to_string(i % 4));
+            protectedOut << sealed.getRecord() << "\n";
+            plainOut << Note(title, sealed.description, vector<string>(1, "travel")).getRecord() << "\n"; // Same record size
+        }
+    }
+    cout << "Protected notes, " << noteCount << " per file\n" << fixed << setprecision(3)
+        << "  sealing: " << secondsSince(start) * 1e6 / noteCount << " us/note (one key derivation each)\n";
 
-// Merge sort function for sorting tasks
-void mergeSort(vector<Task*>& tasks, int left, int right) {
-    if (left >= right) {
-        return; // Recursively return if there is only one element
+    for (int sealed = 0; sealed < 2; sealed++) {
+        ItemStore store;
+        start = chrono::steady_clock::now();
+        loadDataFromFile(sealed ? protectedFile : plainFile, store);
+        cout << "  load " << (sealed ? "sealed protected notes: " : "plain notes:            ") << secondsSince(start) * 1000 << " ms\n";
     }
-    int mid = left + (right - left) / 2; // Calculate the middle point
-    mergeSort(tasks, left, mid); // Recursively sort the left half
-    mergeSort(tasks, mid + 1, right); // Recursively sort the right half
-    merge(tasks, left, mid, right); // Merge the two halves
+
+    ItemStore store;
+    loadDataFromFile(protectedFile, store);
+    vector<ProtectedNote*> notes = store.snapshotOf<ProtectedNote>();
+    string details;
+    start = chrono::steady_clock::now();
+    bool rejected = !notes[0]->unlock("a password not used before", details);
+    cout << "  first unlock of a note (key derivation), wrong password " << (rejected ? "rejected" : "ACCEPTED") << ": "
+        << secondsSince(start) * 1000 << " ms\n";
+    start = chrono::steady_clock::now();
+    size_t openedCount = 0;
+    for (size_t i = 0; i < notes.size(); i += 4) {
+        openedCount += notes[i]->unlock("password0", details);
+    }
+    cout << "  unlocks with a cached key: " << secondsSince(start) * 1e6 / max<size_t>(1, openedCount) << " us/note (" << openedCount << " opened)\n";
+    remove(protectedFile.c_str());
+    remove(plainFile.c_str());
 }
 
-// Function to merge two halves of a vector sorted by task deadline
-void mergeByDeadline(vector<Task*>& tasks, int left, int mid, int right) {
-    int n1 = mid - left + 1; // Number of elements in the first half
-    int n2 = right - mid; // Number of elements in the second half
+// Timing state of one microbenchmark run, in the style of Google Benchmark:
+//     while (state.keepRunning()) { ... }
+// Setup that has to be redone every iteration goes between pauseTiming() and resumeTiming()
+class MicroBenchState {
+public:
+    MicroBenchState(uint64_t iterations) : remaining(iterations), pausedReal(0), pausedCpu(0) {}
 
-    vector<Task*> L(n1), R(n2); // Temporary arrays for left and right halves
+    bool keepRunning() {
+        return remaining-- > 0;
+    }
 
-    // Copy data to temporary arrays L[] and R[]
-    for (int i = 0; i < n1; i++)
-        L[i] = tasks[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = tasks[mid + 1 + j];
+    void pauseTiming() {
+        pauseStart = chrono::steady_clock::now();
+        pauseCpuStart = clock();
+    }
 
-    int i = 0; // Initial index of first subarray
-    int j = 0; // Initial index of second subarray
-    int k = left; // Initial index of merged subarray
-    // Merge the temp arrays back into tasks[left..right]
-    while (i < n1 && j < n2) {
-        if (L[i]->deadline <= R[j]->deadline) {
-            tasks[k] = L[i++];
+    void resumeTiming() {
+        pausedReal += secondsSince(pauseStart);
+        pausedCpu += static_cast<double>(clock() - pauseCpuStart) / CLOCKS_PER_SEC;
+    }
+
+    uint64_t remaining;
+    double pausedReal, pausedCpu;
+
+private:
+    chrono::steady_clock::time_point pauseStart;
+    clock_t pauseCpuStart;
+};
+
+struct MicroBenchResult {
+    string name;
+    string runType; // "iteration" or "aggregate"
+    string aggregate; // mean, median or stddev for aggregates
+    uint64_t iterations;
+    double realNs, cpuNs; // Per iteration
+};
+
+// Runs registered microbenchmarks, growing the iteration count until a run takes at least
+// minSeconds, and reports each repetition plus mean/median/stddev when repeated
+class MicroBenchRunner {
+public:
+    MicroBenchRunner(double minSeconds, int repetitions, const string& filter) :
+        minSeconds(minSeconds), repetitions(max(1, repetitions)), filter(filter) {}
+
+    void run(const string& name, const function<void(MicroBenchState&)>& body) {
+        if (!filter.empty() && name.find(filter) == string::npos) {
+            return;
         }
-        else {
-            tasks[k] = R[j++];
+        vector<double> realTimes, cpuTimes;
+        uint64_t iterations = 1;
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            double real, cpu;
+            while (true) {
+                MicroBenchState state(iterations);
+                auto start = chrono::steady_clock::now();
+                clock_t cpuStart = clock();
+                body(state);
+                real = secondsSince(start) - state.pausedReal;
+                cpu = static_cast<double>(clock() - cpuStart) / CLOCKS_PER_SEC - state.pausedCpu;
+                if (real >= minSeconds || iterations >= 1000000000) {
+                    break;
+                }
+                // Aim 40% past the minimum time, growing at most tenfold per attempt
+                double factor = real > 0 ? minSeconds * 1.4 / real : 10.0;
+                iterations = max(iterations + 1, static_cast<uint64_t>(iterations * min(10.0, factor)));
+            }
+            realTimes.push_back(real * 1e9 / iterations);
+            cpuTimes.push_back(cpu * 1e9 / iterations);
+            report({ name, "iteration", "", iterations, realTimes.back(), cpuTimes.back() });
+        }
+        if (repetitions > 1) {
+            report({ name + "_mean", "aggregate", "mean", iterations, mean(realTimes), mean(cpuTimes) });
+            report({ name + "_median", "aggregate", "median", iterations, median(realTimes), median(cpuTimes) });
+            report({ name + "_stddev", "aggregate", "stddev", iterations, stddev(realTimes), stddev(cpuTimes) });
         }
-        k++;
     }
 
-    // Copy the remaining elements of L[], if any
-    while (i < n1) {
-        tasks[k++] = L[i++];
-    }
-    // Copy the remaining elements of R[], if any
-    while (j < n2) {
-        tasks[k++] = R[j++];
+    // Google Benchmark's JSON layout, so its compare.py and dashboards can read the file
+    bool writeJson(const string& filename) const {
+        ofstream out(filename);
+        time_t now = time(nullptr);
+        char date[32];
+        tm local;
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &local);
+        out << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"executable\": \"GTN_Manager\",\n"
+            << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+            << "    \"library_build_type\": \"release\"\n"
+#else
+            << "    \"library_build_type\": \"debug\"\n"
+#endif
+            << "  },\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const MicroBenchResult& result = results[i];
+            string baseName = result.runType == "aggregate" ? result.name.substr(0, result.name.rfind('_')) : result.name;
+            out << (i ? "," : "") << "\n    {\n      \"name\": \"" << result.name << "\",\n      \"run_name\": \"" << baseName
+                << "\",\n      \"run_type\": \"" << result.runType << "\",\n";
+            if (!result.aggregate.empty()) {
+                out << "      \"aggregate_name\": \"" << result.aggregate << "\",\n";
+            }
+            out << "      \"repetitions\": " << repetitions << ",\n      \"iterations\": " << result.iterations << ",\n"
+                << setprecision(6) << fixed << "      \"real_time\": " << result.realNs << ",\n      \"cpu_time\": " << result.cpuNs
+                << ",\n      \"time_unit\": \"ns\"\n    }";
+        }
+        out << "\n  ]\n}\n";
+        return static_cast<bool>(out);
     }
-}
 
-// Function to sort tasks by their deadlines using merge sort
-void mergeSortByDeadline(vector<Task*>& tasks, int left, int right) {
-    if (left >= right) return; // Base case for recursion
-    int mid = left + (right - left) / 2;
-    mergeSortByDeadline(tasks, left, mid); // Sort the first half
-    mergeSortByDeadline(tasks, mid + 1, right); // Sort the second half
-    mergeByDeadline(tasks, left, mid, right); // Merge the two halves
-}
+    const vector<MicroBenchResult>& getResults() const {
+        return results;
+    }
 
-// Function to display all items in the inventory
-void displayAllItems(const vector<Item*>& items) {
-    for (auto& item : items) {
-        item->display(); // Call the display function polymorphically
-        cout << endl;
+    static double median(vector<double> values) {
+        sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
     }
-}
 
-// Function to handle tasks submenu
-void handleTasks(vector<Item*>& items) {
-    int taskChoice;
-    do {
-        cout << "-----------------------------------------\n\n";
-        cout << "\tTasks Menu\n\n";
-        cout << "1. Display All Tasks\n";
-        cout << "2. View Generic Tasks Details\n";
-        cout << "3. View Recurring Tasks Details\n";
-        cout << "4. View One-Time Tasks Details\n";
-        cout << "5. Sort tasks by priority\n";
-        cout << "6. Sort Tasks by deadline\n";
-        cout << "7. Go Back\n\n";
-        cout << "-----------------------------------------\n";
+private:
+    void report(const MicroBenchResult& result) {
+        cout << left << setw(52) << result.name << right << fixed << setprecision(0) << setw(14) << result.realNs << " ns"
+            << setw(14) << result.cpuNs << " ns" << setw(12) << result.iterations << endl;
+        results.push_back(result);
+    }
 
-        if (!(cin >> taskChoice)) {
-            cin.clear(); // Clears error state of the stream
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignores incorrect input up to the maximum limit
-            cout << "Invalid input. Please enter a number.\n";
-            continue; // Continue to the next iteration of the loop
+    static double mean(const vector<double>& values) {
+        double sum = 0;
+        for (double value : values) {
+            sum += value;
         }
+        return sum / values.size();
+    }
 
-        vector<Task*> tasks;
-        for (auto& item : items) {
-            if (Task* task = dynamic_cast<Task*>(item)) {
-                tasks.push_back(task);
-            }
+    static double stddev(const vector<double>& values) {
+        double average = mean(values), sum = 0;
+        for (double value : values) {
+            sum += (value - average) * (value - average);
         }
+        return values.size() > 1 ? sqrt(sum / (values.size() - 1)) : 0;
+    }
 
-        switch (taskChoice) {
-        case 1:
-            cout << "All Tasks:\n\n";
-            for (auto& task : tasks) {// Displays all tasks 
-                task->display();
-                cout << endl;
+    double minSeconds;
+    int repetitions;
+    string filter;
+    vector<MicroBenchResult> results;
+};
+
+// Written by the benchmarks so the optimizer cannot drop the calls being measured
+volatile size_t benchSink = 0;
+
+// Input orderings the sorting benchmarks are run on
+const char* const benchDistributions[] = { "sorted", "reversed", "random", "duplicates" };
+
+// Sort keys 0..n-1 in the given ordering; "duplicates" draws from only ten distinct values
+vector<int> benchKeys(size_t n, const string& distribution, unsigned seed) {
+    vector<int> keys(n);
+    mt19937 rng(seed);
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = distribution == "reversed" ? static_cast<int>(n - 1 - i) : distribution == "duplicates" ? static_cast<int>(rng() % 10) : static_cast<int>(i);
+    }
+    if (distribution == "random") {
+        shuffle(keys.begin(), keys.end(), rng);
+    }
+    return keys;
+}
+
+// Benchmarks of the sorting and searching algorithms used by the menus, and of the loader,
+// over several input sizes and orderings
+void runAlgorithmBenchmarks(MicroBenchRunner& runner) {
+    const size_t sizes[] = { 1 << 10, 1 << 13, 1 << 16 };
+    cout << left << setw(52) << "Benchmark" << right << setw(17) << "Time" << setw(17) << "CPU" << setw(12) << "Iterations" << "\n"
+        << string(98, '-') << endl;
+
+    for (size_t n : sizes) {
+        for (const char* distribution : benchDistributions) {
+            string suffix = string("/") + distribution + "/" + to_string(n);
+            vector<int> keys = benchKeys(n, distribution, 7);
+            vector<Task*> tasks;
+            vector<Goal*> goals;
+            for (size_t i = 0; i < n; i++) {
+                tasks.push_back(new Task("task", "", formatDate(19000 + keys[i]), keys[i]));
+                goals.push_back(new Goal("goal", "", keys[i] / static_cast<double>(n)));
             }
-            break;
-        case 2:
-            cout << "\tGeneric Tasks Details:\n\n";
-            for (auto& task : tasks) { //Goes through and shows all generic task details
-                if (task != nullptr && dynamic_cast<RecurringTask*>(task) == nullptr && dynamic_cast<OneTimeTask*>(task) == nullptr) {
-                    cout << task->getDetails() << endl << endl;
+            // The merge step alone gets two halves that are each already sorted
+            vector<Task*> halves = tasks;
+            int mid = static_cast<int>(n / 2) - 1;
+            sort(halves.begin(), halves.begin() + mid + 1, [](Task* a, Task* b) { return a->priority < b->priority; });
+            sort(halves.begin() + mid + 1, halves.end(), [](Task* a, Task* b) { return a->priority < b->priority; });
+
+            vector<Task*> taskWork;
+            vector<Goal*> goalWork;
+            runner.run("BM_merge" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    taskWork = halves;
+                    state.resumeTiming();
+                    merge(taskWork, 0, mid, static_cast<int>(n) - 1);
                 }
-                else if (task == nullptr) {
-                    cout << "Error: Encountered a null task pointer." << endl;
+            });
+            runner.run("BM_mergeSort" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    taskWork = tasks;
+                    state.resumeTiming();
+                    mergeSort(taskWork, 0, static_cast<int>(n) - 1);
                 }
-            }
-            break;
-        case 3:
-            cout << "\tAll Recurring Tasks Details:\n" << endl;
-            for (auto& task : tasks) {//Goes through and shows all Recurring task details
-                if (RecurringTask* recurringTask = dynamic_cast<RecurringTask*>(task)) {
-                    cout << recurringTask->getDetails() << endl << endl;
+            });
+            runner.run("BM_mergeByDeadline" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    taskWork = halves;
+                    state.resumeTiming();
+                    mergeByDeadline(taskWork, 0, mid, static_cast<int>(n) - 1); // Priority and deadline orders agree
                 }
-            }
-            break;
-        case 4:
-            cout << "\tAll One-Time Tasks Details:\n" << endl;
-            for (auto& task : tasks) {//Goes through and shows all Non-Recurring task details
-                if (OneTimeTask* oneTimeTask = dynamic_cast<OneTimeTask*>(task)) {
-                    cout << oneTimeTask->getDetails() << endl << endl;
+            });
+            runner.run("BM_mergeSortByDeadline" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    taskWork = tasks;
+                    state.resumeTiming();
+                    mergeSortByDeadline(taskWork, 0, static_cast<int>(n) - 1);
                 }
+            });
+            runner.run("BM_heapSort" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    goalWork = goals;
+                    state.resumeTiming();
+                    heapSort(goalWork);
+                }
+            });
+            runner.run("BM_heapify" + suffix, [&](MicroBenchState& state) {
+                while (state.keepRunning()) { // Heap construction only
+                    state.pauseTiming();
+                    goalWork = goals;
+                    state.resumeTiming();
+                    for (int i = static_cast<int>(n) / 2 - 1; i >= 0; i--) {
+                        heapify(goalWork, static_cast<int>(n), i);
+                    }
+                }
+            });
+            for (Task* task : tasks) {
+                delete task;
             }
-            break;
-        case 5:
-            mergeSort(tasks, 0, tasks.size() - 1);
-            cout << "\tTasks sorted by priority:\n" << endl;
-            for (auto& task : tasks) {
-                task->display();
-                cout << endl;
-            }
-            break;
-        case 6:
-            mergeSortByDeadline(tasks, 0, tasks.size() - 1);
-            cout << "\tTasks sorted by deadline:\n" << endl;
-            for (auto& task : tasks) {
-                task->display();
-                cout << endl;
+            for (Goal* goal : goals) {
+                delete goal;
             }
-            break;
-        case 7:
-            return; // Exit the task menu
-        default:
-            cout << "Invalid choice, please choose again." << endl;
-            break;
         }
-        // Clears any extraneous input.
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    } while (taskChoice != 7);
-}
-
-// Heapify function for HeapSort adjusted for goals
-void heapify(vector<Goal*>& goals, int n, int i) {
-    int largest = i;  // Initialize largest as root
-    int left = 2 * i + 1;  // Left child index
-    int right = 2 * i + 2; // Right child index
+    }
 
-    // Check if left child exists and is greater than root
-    if (left < n && goals[left]->getProgress() > goals[largest]->getProgress() && goals[left]->getProgress() != -1)
-        largest = left;
+    // Text benchmarks: "random" text never contains the pattern (a full scan), "repetitive" text
+    // and pattern ("aaa...ab") make KMP fall back through the prefix table at every position
+    mt19937 rng(3);
+    for (size_t n : sizes) {
+        string randomText(n, ' '), repetitiveText(n, 'a');
+        for (char& c : randomText) {
+            c = "abcdefghijklmnopqrstuvwxyz "[rng() % 27];
+        }
+        string randomPattern = randomText.substr(n / 3, 16) + "#", repetitivePattern = string(63, 'a') + "b";
+        string suffix = "/" + to_string(n);
+        bool found = false;
+        runner.run("BM_KMPSearch/random" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                found ^= KMPSearch(randomText, randomPattern);
+            }
+        });
+        runner.run("BM_KMPSearch/repetitive" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                found ^= KMPSearch(repetitiveText, repetitivePattern);
+            }
+        });
+        size_t tableSum = 0;
+        runner.run("BM_computeKMPTable/random" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                tableSum += computeKMPTable(randomText).back();
+            }
+        });
+        runner.run("BM_computeKMPTable/repetitive" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                tableSum += computeKMPTable(repetitiveText).back();
+            }
+        });
 
-    // Check if right child exists and is greater than the current largest
-    if (right < n && goals[right]->getProgress() > goals[largest]->getProgress() && goals[right]->getProgress() != -1)
-        largest = right;
+        string mixedCase = randomText;
+        for (size_t i = 0; i < n; i += 2) {
+            mixedCase[i] = static_cast<char>(toupper(static_cast<unsigned char>(mixedCase[i])));
+        }
+        runner.run("BM_toLowerCase" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                tableSum += toLowerCase(mixedCase).size();
+            }
+        });
+        // Records of n bytes split on commas: short fields (like tags) and long ones (like descriptions)
+        string shortFields, longFields;
+        while (shortFields.size() < n) {
+            shortFields += "gym,";
+        }
+        while (longFields.size() < n) {
+            longFields += randomText.substr(0, 60) + ",";
+        }
+        runner.run("BM_split/short_fields" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                tableSum += split(shortFields, ',').size();
+            }
+        });
+        runner.run("BM_split/long_fields" + suffix, [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                tableSum += split(longFields, ',').size();
+            }
+        });
+        benchSink = benchSink + tableSum + found; // Keeps the results observable so the calls are not optimized away
+    }
 
-    // If largest is not root, swap and continue heapifying
-    if (largest != i) {
-        swap(goals[i], goals[largest]);
-        heapify(goals, n, largest);
+    string dataFile = "bench_algorithms_data.txt";
+    for (size_t n : sizes) {
+        {
+            ofstream out(dataFile);
+            for (Item* item : generateSampleItems(n, 5)) {
+                out << item->getRecord() << "\n";
+                delete item;
+            }
+        }
+        runner.run("BM_loadDataFromFile/" + to_string(n), [&](MicroBenchState& state) {
+            while (state.keepRunning()) {
+                unique_ptr<ItemStore> store(new ItemStore());
+                loadDataFromFile(dataFile, *store);
+                state.pauseTiming(); // Freeing the items is not part of the load
+                store.reset();
+                state.resumeTiming();
+            }
+        });
     }
+    remove(dataFile.c_str());
 }
 
-// HeapSort function to sort goals by progress
-void heapSort(vector<Goal*>& goals) {
-    int n = goals.size();
-
-    // Build heap from the array
-    for (int i = n / 2 - 1; i >= 0; i--)
-        heapify(goals, n, i);
-
-    // Extract elements one by one from the heap
-    for (int i = n - 1; i >= 0; i--) {
-        // Move current root to end
-        swap(goals[0], goals[i]);
-
-        // Call heapify on the reduced heap
-        heapify(goals, i, 0);
+// Runs the algorithm benchmarks; results go to the console and, optionally, JSON.
+// Returns false if the JSON file could not be written.
+bool benchmarkAlgorithms(const string& jsonFile, const string& filter, double minSeconds, int repetitions) {
+    MicroBenchRunner runner(minSeconds, repetitions, filter);
+    runAlgorithmBenchmarks(runner);
+    if (jsonFile.empty()) {
+        return true;
     }
+    bool written = runner.writeJson(jsonFile);
+    cout << (written ? "Results written to " : "Could not write ") << jsonFile << endl;
+    return written;
 }
 
-void handleGoals(vector<Item*>& items) {
-    int goalChoice;
-    do {
-        cout << "-----------------------------------------\n";
-        cout << "\tGoals Menu\n\n";
-        cout << "1. Display All Goals\n";
-        cout << "2. View Generic Goals Details\n";
-        cout << "3. View Quantifiable Goals Details\n";
-        cout << "4. View Non-Quantifiable Goals Details\n";
-        cout << "5. Sort goals by progress\n";
-        cout << "6. Go Back\n";
-        cout << "-----------------------------------------\n";
-
-        if (!(cin >> goalChoice)) {
-            cin.clear(); // Clear error state
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
-            cout << "Invalid input. Please enter a number.\n";
-            continue;
+// Minimal JSON reader for benchmark result files: walks any layout (pretty-printed or on one line)
+// and collects every object's scalar members as text. Nested values are read recursively; the
+// objects are returned innermost first. Returns false on malformed JSON.
+class JsonObjectReader {
+public:
+    JsonObjectReader(const string& text) : text(text), position(0) {}
+
+    bool read(vector<map<string, string>>& objects) {
+        string ignored;
+        if (!readValue(objects, ignored)) {
+            return false;
         }
+        skipSpace();
+        return position == text.size();
+    }
 
-        vector<Goal*> allGoals;
-        for (auto& item : items) {
-            if (Goal* goal = dynamic_cast<Goal*>(item)) {
-                allGoals.push_back(goal);
-            }
+private:
+    void skipSpace() {
+        while (position < text.size() && isspace(static_cast<unsigned char>(text[position]))) {
+            position++;
         }
+    }
 
-        switch (goalChoice) {
-        case 1:
-            cout << "\tAll Goals:\n" << endl;
-            for (auto& goal : allGoals) {
-                goal->display();
-                cout << endl;
-            }
-            break;
-        case 2:
-            cout << "\tGeneric Goals Details:\n\n";
-            for (auto& goal : allGoals) {
-                if (goal != nullptr) {
-                    QuantifiableGoal* quantGoal = dynamic_cast<QuantifiableGoal*>(goal);
-                    NonQuantifiableGoal* nonQuantGoal = dynamic_cast<NonQuantifiableGoal*>(goal);
-                    if (!quantGoal && !nonQuantGoal) {
-                        cout << goal->getDetails() << endl << endl;
-                    }
+    bool readString(string& out) {
+        if (position >= text.size() || text[position] != '"') {
+            return false;
+        }
+        for (position++; position < text.size() && text[position] != '"'; position++) {
+            if (text[position] == '\\') {
+                if (++position == text.size()) {
+                    return false;
                 }
-                else {
-                    cout << "Error: Encountered a null goal pointer." << endl;
+                char escaped = text[position];
+                if (escaped == 'u') {
+                    if (position + 4 >= text.size()) {
+                        return false;
+                    }
+                    out += '?'; // Benchmark names are ASCII; other code points are not needed
+                    position += 4;
+                    continue;
                 }
+                out += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped == 'r' ? '\r' : escaped == 'b' ? '\b' : escaped == 'f' ? '\f' : escaped;
             }
-            break;
-        case 3:
-            cout << "\tQuantifiable Goals Details:\n" << endl;
-            for (auto& item : items) {
-                QuantifiableGoal* quantGoal = dynamic_cast<QuantifiableGoal*>(item);
-                if (quantGoal) {
-                    cout << quantGoal->getDetails() << endl << endl;
-                }
+            else {
+                out += text[position];
             }
-            break;
-        case 4:
-            cout << "\tNon-Quantifiable Goals Details:\n" << endl;
-            for (auto& goal : allGoals) {
-                if (goal->getProgress() == -1) {
-                    cout << goal->getDetails() << endl << endl;
+        }
+        if (position == text.size()) {
+            return false;
+        }
+        position++;
+        return true;
+    }
+
+    // Reads one value; scalars are returned as text in scalar, objects are added to objects
+    bool readValue(vector<map<string, string>>& objects, string& scalar) {
+        skipSpace();
+        if (position >= text.size()) {
+            return false;
+        }
+        char c = text[position];
+        if (c == '"') {
+            return readString(scalar);
+        }
+        if (c == '{' || c == '[') {
+            bool isObject = c == '{';
+            map<string, string> members;
+            position++;
+            skipSpace();
+            if (position < text.size() && text[position] == (isObject ? '}' : ']')) {
+                position++;
+            }
+            else {
+                while (true) {
+                    string key, value;
+                    skipSpace();
+                    if (isObject) {
+                        if (!readString(key)) {
+                            return false;
+                        }
+                        skipSpace();
+                        if (position >= text.size() || text[position++] != ':') {
+                            return false;
+                        }
+                    }
+                    if (!readValue(objects, value)) {
+                        return false;
+                    }
+                    if (isObject) {
+                        members[key] = value;
+                    }
+                    skipSpace();
+                    if (position < text.size() && text[position] == ',') {
+                        position++;
+                        continue;
+                    }
+                    if (position < text.size() && text[position] == (isObject ? '}' : ']')) {
+                        position++;
+                        break;
+                    }
+                    return false;
                 }
             }
-            break;
-        case 5:
-            heapSort(allGoals);
-            cout << "\tGoals sorted by progress:\n" << endl;
-            for (auto& goal : allGoals) {
-                goal->display();
-                cout << endl;
+            if (isObject) {
+                objects.push_back(move(members));
             }
-            break;
-        case 6:
-            return;  // Exit the loop
-        default:
-            cout << "Invalid choice, please choose again." << endl;
+            return true;
         }
-        // Clear the buffer to handle any extraneous input.
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    } while (goalChoice != 6);
-}
+        size_t start = position; // Number, true, false or null
+        while (position < text.size() && (isalnum(static_cast<unsigned char>(text[position])) || text[position] == '-' || text[position] == '+' || text[position] == '.')) {
+            position++;
+        }
+        scalar = text.substr(start, position - start);
+        return position > start;
+    }
 
+    const string& text;
+    size_t position;
+};
 
-// Helper function to search for notes by a specific tag.
-void searchNotesByTag(const vector<Note*>& notes, const string& tag) {
-    bool found = false;
-    for (auto note : notes) {
-        // Check if the tag exists in the note's tags vector.
-        if (find(note->tags.begin(), note->tags.end(), tag) != note->tags.end()) {
-            note->display(); // Display the note if the tag is found.
-            cout << endl;
-            found = true;
+// Per-repetition real times (ns per iteration) of each benchmark in a Google Benchmark JSON file,
+// keyed by run name; aggregates are skipped since they are recomputed from the repetitions.
+// Returns false, with the reason in error, if the file cannot be read or holds no repetitions.
+bool readBenchmarkRepetitions(const string& filename, map<string, vector<double>>& repetitions, string& error) {
+    ifstream in(filename, ios::binary);
+    if (!in) {
+        error = "cannot open " + filename;
+        return false;
+    }
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    vector<map<string, string>> objects;
+    if (!JsonObjectReader(text).read(objects)) {
+        error = filename + " is not valid JSON";
+        return false;
+    }
+    for (map<string, string>& benchmark : objects) {
+        if (!benchmark.count("real_time") || (benchmark.count("run_type") && benchmark["run_type"] != "iteration")) {
+            continue;
+        }
+        const string& unit = benchmark.count("time_unit") ? benchmark["time_unit"] : "ns";
+        double scale = unit == "ns" ? 1 : unit == "us" ? 1e3 : unit == "ms" ? 1e6 : unit == "s" ? 1e9 : 0;
+        char* end = nullptr;
+        double time = strtod(benchmark["real_time"].c_str(), &end);
+        if (scale == 0 || *end != '\0') {
+            error = filename + ": unreadable time \"" + benchmark["real_time"] + " " + unit + "\"";
+            return false;
         }
+        string name = benchmark.count("run_name") ? benchmark["run_name"] : benchmark["name"];
+        repetitions[name].push_back(time * scale);
     }
-    // If no note with the tag is found, print a message indicating so.
-    if (!found) {
-        cout << "No notes found with that tag." << endl;
+    if (repetitions.empty()) {
+        error = filename + " contains no benchmark repetitions";
+        return false;
     }
+    return true;
 }
 
-// Helper function to compute the partial match table 
-vector<int> computeKMPTable(const string& pattern) {
-    int m = pattern.size(); // The length of the pattern
-    vector<int> lps(m, 0); // Longest prefix which is also suffix
-    int len = 0; // length of the previous longest prefix suffix
-    int i = 1; // index for which we are computing the lps value
-
-    // Loop to fill lps array
-    while (i < m) {
-        if (pattern[i] == pattern[len]) {
-            lps[i++] = ++len;
-        }
-        else if (len) {
-            len = lps[len - 1];
+// 95% bootstrap confidence interval of median(current) / median(baseline)
+pair<double, double> medianRatioInterval(const vector<double>& baseline, const vector<double>& current, mt19937& rng) {
+    const int resamples = 2000;
+    vector<double> ratios, baselineSample(baseline.size()), currentSample(current.size());
+    for (int r = 0; r < resamples; r++) {
+        for (double& value : baselineSample) {
+            value = baseline[rng() % baseline.size()];
         }
-        else {
-            lps[i++] = 0;
+        for (double& value : currentSample) {
+            value = current[rng() % current.size()];
         }
+        ratios.push_back(MicroBenchRunner::median(currentSample) / MicroBenchRunner::median(baselineSample));
     }
-    return lps;
+    sort(ratios.begin(), ratios.end());
+    return { ratios[resamples / 40], ratios[resamples - 1 - resamples / 40] };
 }
 
-// Function to search a text for a given pattern using the KMP searching algorithm.
-bool KMPSearch(const string& text, const string& pattern) {
-    if (pattern.empty()) return false; // Handle the edge case where pattern is an empty string.
-
-    int n = text.size(); // The length of the text to search within.
-    int m = pattern.size(); // The length of the pattern to search for.
-    int i = 0; // Index for text.
-    int j = 0; // Index for pattern.
-
-    vector<int> lps = computeKMPTable(pattern); // Preprocess the pattern to create the lps array.
+// Regression gate: runs the algorithm benchmarks and compares the median of each against the
+// baseline file. A benchmark regresses only when the whole confidence interval of the median ratio
+// lies above 1 + threshold, so noise between repetitions does not fail the gate. The gate fails
+// closed: a missing or unreadable baseline, or one sharing no benchmark with this run, is a failure.
+// Returns whether no operation regressed.
+bool compareWithBaseline(const string& baselineFile, const string& filter, double minSeconds, int repetitions, double thresholdPercent, const string& resultsFile) {
+    map<string, vector<double>> baseline;
+    string error;
+    if (!readBenchmarkRepetitions(baselineFile, baseline, error)) {
+        cout << "FAILED: " << error << " (record a baseline with \"bench compare --record <baseline>\")" << endl;
+        return false;
+    }
+    MicroBenchRunner runner(minSeconds, repetitions, filter);
+    runAlgorithmBenchmarks(runner);
+    if (!resultsFile.empty()) {
+        cout << (runner.writeJson(resultsFile) ? "Results written to " : "Could not write ") << resultsFile << endl;
+    }
 
-    // Loop through the text to find the pattern.
-    while (i < n) {
-        if (text[i] == pattern[j]) {
-            if (++j == m) {
-                return true; // Match found when we reach the end of the pattern.
-            }
-            i++;
+    map<string, vector<double>> current;
+    for (const MicroBenchResult& result : runner.getResults()) {
+        if (result.runType == "iteration") {
+            current[result.name].push_back(result.realNs);
         }
-        else if (j) {
-            j = lps[j - 1]; // Use lps array to avoid unnecessary comparisons.
+    }
+    double threshold = thresholdPercent / 100;
+    mt19937 rng(12345);
+    map<string, pair<double, string>> regressed; // Operation -> worst change and its benchmark
+    size_t compared = 0, improved = 0, missing = 0;
+    cout << "\n" << left << setw(52) << "Benchmark" << right << setw(14) << "baseline" << setw(14) << "current" << setw(10) << "change"
+        << setw(20) << "95% CI" << "  verdict\n" << string(118, '-') << "\n" << fixed;
+    for (const auto& [name, currentTimes] : current) {
+        auto found = baseline.find(name);
+        if (found == baseline.end()) {
+            missing++;
+            continue;
         }
-        else {
-            i++;
+        const vector<double>& baselineTimes = found->second;
+        double ratio = MicroBenchRunner::median(currentTimes) / MicroBenchRunner::median(baselineTimes);
+        bool haveInterval = baselineTimes.size() >= 3 && currentTimes.size() >= 3;
+        pair<double, double> interval = haveInterval ? medianRatioInterval(baselineTimes, currentTimes, rng) : make_pair(ratio, ratio);
+        string verdict = interval.first > 1 + threshold ? "REGRESSED" : interval.second < 1 - threshold ? "improved" : "same";
+        if (!haveInterval) {
+            verdict += " (no CI, < 3 repetitions)";
+        }
+        cout << left << setw(52) << name << right << setprecision(0) << setw(11) << MicroBenchRunner::median(baselineTimes) << " ns"
+            << setw(11) << MicroBenchRunner::median(currentTimes) << " ns" << setprecision(1) << setw(9) << (ratio - 1) * 100 << "%"
+            << setw(9) << (interval.first - 1) * 100 << "%.." << setw(6) << (interval.second - 1) * 100 << "%" << "  " << verdict << "\n";
+        compared++;
+        improved += verdict.starts_with("improved");
+        if (verdict.starts_with("REGRESSED")) {
+            // BM_mergeSort/random/1024 -> mergeSort
+            string operation = name.substr(name.starts_with("BM_") ? 3 : 0);
+            operation = operation.substr(0, operation.find('/'));
+            if (!regressed.count(operation) || ratio > regressed[operation].first) {
+                regressed[operation] = { ratio, name };
+            }
         }
     }
-    return false; // Return false if no match is found.
+    cout << left;
+    cout << "\n" << compared << " benchmarks compared with " << baselineFile << " (threshold " << setprecision(1) << thresholdPercent << "%), "
+        << improved << " improved";
+    if (missing) {
+        cout << ", " << missing << " not in the baseline";
+    }
+    cout << "\n";
+    if (compared == 0) {
+        cout << "FAILED: no benchmark of this run is in the baseline" << endl;
+        return false;
+    }
+    if (regressed.empty()) {
+        cout << "PASSED: no regressions" << endl;
+        return true;
+    }
+    cout << "FAILED: regressed operations:\n";
+    for (const auto& [operation, worst] : regressed) {
+        cout << "  " << operation << " (" << worst.second << " +" << (worst.first - 1) * 100 << "%)\n";
+    }
+    cout << flush;
+    return false;
 }
 
+// Cost of the instrumentation: a timed scope (two clock reads and a histogram update) and a trace
+// span against the same loop without either, plus the percentile accuracy on a known distribution
+void benchmarkLatencyStats(size_t count) {
+    LatencyHistogram histogram;
+    volatile uint64_t work = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        work = work + i;
+    }
+    double untimed = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        LatencyTimer timer(histogram);
+        work = work + i;
+    }
+    double timed = secondsSince(start);
+    cout << "Latency instrumentation, " << count << " timed scopes" << (GTN_LATENCY_STATS ? "" : " (TIME_OPERATION compiled out in this build)") << "\n"
+        << fixed << setprecision(1) << "  overhead per timed operation: " << (timed - untimed) * 1e9 / count << " ns\n";
 
-// Utility to convert string to lower case
-string toLowerCase(const string& str) {
-    string lowerCaseStr;
-    transform(str.begin(), str.end(), back_inserter(lowerCaseStr),
-        [](unsigned char c) { return tolower(c); });
-    return lowerCaseStr;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        TraceSpan span("bench span");
+        work = work + i;
+    }
+    cout << "  overhead per trace span: " << (secondsSince(start) - untimed) * 1e9 / count << " ns\n";
+
+    LatencyHistogram uniform;
+    start = chrono::steady_clock::now();
+    for (uint64_t value = 1; value <= count; value++) {
+        uniform.record(value * 1000); // 1 us .. count us, evenly spread
+    }
+    cout << "  histogram record: " << secondsSince(start) * 1e9 / count << " ns\n"
+        << "  uniform 1 us.." << formatLatency(count * 1000) << ": p50 " << formatLatency(uniform.percentile(50)) << " (exact " << formatLatency(count * 500)
+        << "), p99 " << formatLatency(uniform.percentile(99)) << " (exact " << formatLatency(count * 990) << "), max " << formatLatency(uniform.max()) << "\n";
 }
 
-// Full text search across all note fields
-void searchNotesFullText(const vector<Note*>& notes, const string& searchText) {
-    bool found = false;
-    cout << "\nSearching all note fields for: " << searchText << "\n\n " << endl;
-    for (const auto& note : notes) {
-        string fullText = note->title + " " + note->description + " ";
-        for (const auto& tag : note->tags) {
-            fullText += tag + " ";
+// A representative session for the "trace" and "perf" commands: sequential and pipelined load,
+// sorts, a full-text search, dashboard rendering, and sequential and pipelined saves
+void runSampleSession(const string& dataFile) {
+    ItemStore store;
+    DashboardAggregates dashboard;
+    store.attachIndex(&dashboard);
+    loadDataFromFile(dataFile, store);
+    {
+        ItemStore pipelined;
+        loadDataPipelined(dataFile, pipelined, max(2u, thread::hardware_concurrency()));
+    }
+    vector<Task*> tasks = store.snapshotOf<Task>();
+    vector<Goal*> goals = store.snapshotOf<Goal>();
+    vector<Note*> notes = store.snapshotOf<Note>();
+    {
+        TIME_OPERATION("mergeSort");
+        mergeSort(tasks, 0, static_cast<int>(tasks.size()) - 1);
+    }
+    {
+        TIME_OPERATION("mergeSortByDeadline");
+        mergeSortByDeadline(tasks, 0, static_cast<int>(tasks.size()) - 1);
+    }
+    {
+        TIME_OPERATION("heapSort");
+        heapSort(goals);
+    }
+    size_t matches = 0;
+    {
+        TIME_OPERATION("notes: full-text search");
+        for (const Note* note : notes) {
+            matches += noteMatchesText(note, "gym");
         }
+    }
+    {
+        TIME_OPERATION("dashboard");
+        ostringstream rendered;
+        streambuf* console = cout.rdbuf(rendered.rdbuf()); // Rendered, but not shown
+        dashboard.display(currentDay());
+        cout.rdbuf(console);
+    }
+    string saveFile = dataFile + ".session";
+    saveDataToFile(saveFile, store);
+    {
+        TIME_OPERATION("save data (pipelined)");
+        saveDataPipelined(saveFile, store, max(2u, thread::hardware_concurrency()));
+    }
+    remove(saveFile.c_str());
+    cout << store.size() << " items, " << matches << " notes matching \"gym\"" << endl;
+}
 
-        // Convert fullText and searchText to lowercase before searching
-        if (KMPSearch(toLowerCase(fullText), toLowerCase(searchText))) {
-            note->display();
-            cout << endl;
-            found = true;
-        }
+// Allocation budgets of common operations on generated data; fails if an operation allocates
+// more than it does today, so new hidden allocations in these paths are caught
+int checkAllocationBudgets(size_t itemCount) {
+    ItemStore store;
+    store.addBatch(generateSampleItems(itemCount, 17));
+    DueDateIndex dueDates;
+    store.attachIndex(&dueDates);
+    vector<Task*> tasks = store.snapshotOf<Task>();
+    vector<Goal*> goals = store.snapshotOf<Goal>();
+    vector<Note*> notes = store.snapshotOf<Note>();
+    size_t taskCount = tasks.size();
+    string record = tasks[0]->getRecord();
+    string lowered = toLowerCase(notes[0]->title + " " + notes[0]->description);
+    int today = currentDay();
+    size_t sink = 0;
+    bool ok = true;
+    cout << "Allocation budgets, " << store.size() << " items (worst of 10 runs after a warm-up)\n";
+    ok &= checkAllocationBudget("ItemStore::find", [&]() { sink += store.find(itemCount / 2) != nullptr; }, 0);
+    ok &= checkAllocationBudget("heapSort", [&]() { heapSort(goals); }, 0);
+    ok &= checkAllocationBudget("KMPSearch (prefix table)", [&]() { sink += KMPSearch(lowered, "gym"); }, 1);
+    ok &= checkAllocationBudget("noteMatchesText", [&]() { sink += noteMatchesText(notes[1], "gym"); }, 3); // Joined text, lowered copy, prefix table
+    ok &= checkAllocationBudget("toLowerCase (64 chars)", [&]() { sink += toLowerCase(string(64, 'A')).size(); }, 4); // Input, then growth by doubling
+    ok &= checkAllocationBudget("Task::getDetails", [&]() { sink += tasks[0]->getDetails().size(); }, 3);
+    ok &= checkAllocationBudget("parseItemLine", [&]() { delete parseItemLine(record); }, 4);
+    ok &= checkAllocationBudget("mergeSort (2 per merge)", [&]() { mergeSort(tasks, 0, static_cast<int>(taskCount) - 1); }, 2 * (taskCount - 1));
+    ok &= checkAllocationBudget("DueDateIndex::query (this week)", [&]() { sink += dueDates.query(today, today + 6).size(); }, 2 * bit_width(taskCount));
+    ok &= checkAllocationBudget("ItemStore::snapshotOf<Task>", [&]() { sink += store.snapshotOf<Task>().size(); }, 2 * bit_width(store.size()));
+    benchSink = benchSink + sink;
+    cout << (ok ? "All allocation budgets met" : "Allocation budget exceeded") << endl;
+    return ok ? 0 : 1;
+}
+
+// Stream buffer that throws its output away; the scaling benchmark renders into it
+class DiscardBuffer : public streambuf {
+public:
+    DiscardBuffer() {
+        setp(buffer, buffer + sizeof(buffer));
     }
 
-    if (!found) {
-        cout << "No matching notes found." << endl;
+protected:
+    int overflow(int c) override {
+        setp(buffer, buffer + sizeof(buffer));
+        return traits_type::not_eof(c);
+    }
+
+private:
+    char buffer[4096];
+};
+
+// One operation measured at growing store sizes
+struct ScalingCurve {
+    string operation;
+    string expected;        // "n" or "n log n"
+    bool allocatesPerItem;  // Whether one or more allocations per item are inherent (loading)
+    vector<size_t> items;
+    vector<double> seconds; // Per run
+    vector<uint64_t> allocations;
+    double exponent = 0, expectedExponent = 0, lastStepExponent = 0;
+    vector<string> flags;
+
+    ScalingCurve(const string& operation, const string& expected, bool allocatesPerItem)
+        : operation(operation), expected(expected), allocatesPerItem(allocatesPerItem) {
+    }
+};
+
+// Least-squares slope of log(y) against log(x)
+double fitLogLogSlope(const vector<double>& x, const vector<double>& y) {
+    double meanX = 0, meanY = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        meanX += log(x[i]) / x.size();
+        meanY += log(y[i]) / y.size();
     }
+    double covariance = 0, variance = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        covariance += (log(x[i]) - meanX) * (log(y[i]) - meanY);
+        variance += (log(x[i]) - meanX) * (log(x[i]) - meanX);
+    }
+    return variance > 0 ? covariance / variance : 0;
 }
 
-void handleNotes(vector<Item*>& items) {
-    int noteChoice;
-    do {
-        cout << "-----------------------------------------\n";
-        cout << "\tNotes Menu\n\n";
-        cout << "1. Display All Notes\n";
-        cout << "2. View Generic Notes Details\n";
-        cout << "3. View Protected Notes Details\n";
-        cout << "4. View Unprotected Notes Details\n";
-        cout << "5. Search for a note (full text)\n";
-        cout << "6. Search note by tags\n";
-        cout << "7. Go Back\n";
-        cout << "-----------------------------------------\n";
+// Fits the empirical exponent (time ~ n^k) and flags growth beyond the expected complexity:
+// a fitted or last-decade exponent clearly above that of n or n log n over the same sizes points to
+// quadratic scans or deep recursion (cache misses alone add about 0.1-0.3 once the data outgrows
+// the caches, hence the margins), and allocations growing with n point to per-item allocation
+void fitScalingCurve(ScalingCurve& curve) {
+    vector<double> n(curve.items.begin(), curve.items.end()), model;
+    for (double items : n) {
+        model.push_back(curve.expected == "n log n" ? items * log2(items) : items);
+    }
+    curve.exponent = fitLogLogSlope(n, curve.seconds);
+    curve.expectedExponent = fitLogLogSlope(n, model);
+    size_t last = n.size() - 1;
+    curve.lastStepExponent = log(curve.seconds[last] / curve.seconds[last - 1]) / log(n[last] / n[last - 1]);
+    double lastStepExpected = log(model[last] / model[last - 1]) / log(n[last] / n[last - 1]);
+    if (curve.exponent > curve.expectedExponent + 0.35) {
+        curve.flags.push_back("super-linear: fitted n^" + to_string(curve.exponent).substr(0, 4) + ", expected " + curve.expected);
+    }
+    else if (curve.lastStepExponent > lastStepExpected + 0.5) {
+        curve.flags.push_back("growth accelerates at the largest size (n^" + to_string(curve.lastStepExponent).substr(0, 4) + ")");
+    }
+    double allocationsPerItem = static_cast<double>(curve.allocations[last]) / n[last];
+    if (!curve.allocatesPerItem && allocationsPerItem >= 0.5) {
+        curve.flags.push_back("per-item allocation: " + to_string(allocationsPerItem).substr(0, 4) + " allocations per item");
+    }
+}
 
-        if (!(cin >> noteChoice)) {
-            cin.clear(); // Clear error state
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard bad input
-            cout << "Invalid input. Please enter a number.\n";
-            continue;
+// Measures one operation: repeats it until minSeconds have passed (at least once) and keeps the
+// fastest run; allocations are counted on one further run
+void measureScaling(ScalingCurve& curve, size_t items, const function<void()>& prepare, const function<void()>& run, double minSeconds) {
+    double best = numeric_limits<double>::max(), total = 0;
+    while (total < minSeconds || best == numeric_limits<double>::max()) {
+        prepare();
+        auto start = chrono::steady_clock::now();
+        run();
+        double elapsed = secondsSince(start);
+        best = min(best, elapsed);
+        total += elapsed;
+    }
+    prepare();
+    curve.items.push_back(items);
+    curve.seconds.push_back(best);
+    curve.allocations.push_back(allocationsDuring(run).allocations);
+}
+
+// Scalability benchmark: load, save, sorts, searches and rendering over generated stores of 10^3
+// up to maxItems items, with fitted exponents, flags for super-linear growth, and CSV/JSON curves
+void benchmarkScaling(size_t maxItems, const string& csvFile, const string& jsonFile) {
+    vector<ScalingCurve> curves = {
+        { "load", "n", true }, { "save", "n", false }, { "mergeSort", "n log n", false }, { "mergeSortByDeadline", "n log n", false },
+        { "heapSort", "n log n", false }, { "full-text search", "n", false }, { "tag search", "n", false }, { "display all", "n", false },
+    };
+    string dataFile = "bench_scaling_data.txt";
+    DiscardBuffer discard;
+    cout << "Scalability from 1000 to " << maxItems << " items" << endl;
+    for (size_t items = 1000; items <= maxItems; items *= 10) {
+        {
+            ofstream out(dataFile);
+            for (size_t done = 0; done < items; done += 1000000) { // Generated in chunks to bound memory
+                for (Item* item : generateSampleItems(min<size_t>(1000000, items - done), static_cast<unsigned>(done + 1))) {
+                    out << item->getRecord() << "\n";
+                    delete item;
+                }
+            }
         }
+        double minSeconds = 0.2;
+        unique_ptr<ItemStore> store;
+        measureScaling(curves[0], items, [&]() { store.reset(new ItemStore()); }, [&]() { loadDataFromFile(dataFile, *store); }, minSeconds);
+        string saveFile = dataFile + ".saved";
+        measureScaling(curves[1], items, []() {}, [&]() { saveDataToFile(saveFile, *store); }, minSeconds);
+        remove(saveFile.c_str());
 
-        vector<Note*> notes;
-        for (auto& item : items) {
-            if (Note* note = dynamic_cast<Note*>(item)) {
-                notes.push_back(note);
+        vector<Task*> tasks = store->snapshotOf<Task>(), sortedTasks;
+        vector<Goal*> goals = store->snapshotOf<Goal>(), sortedGoals;
+        vector<Note*> notes = store->snapshotOf<Note>();
+        int last = static_cast<int>(tasks.size()) - 1;
+        measureScaling(curves[2], items, [&]() { sortedTasks = tasks; }, [&]() { mergeSort(sortedTasks, 0, last); }, minSeconds);
+        measureScaling(curves[3], items, [&]() { sortedTasks = tasks; }, [&]() { mergeSortByDeadline(sortedTasks, 0, last); }, minSeconds);
+        measureScaling(curves[4], items, [&]() { sortedGoals = goals; }, [&]() { heapSort(sortedGoals); }, minSeconds);
+        size_t matches = 0;
+        measureScaling(curves[5], items, []() {}, [&]() {
+            for (const Note* note : notes) {
+                matches += noteMatchesText(note, "gym");
+            }
+        }, minSeconds);
+        measureScaling(curves[6], items, []() {}, [&]() {
+            for (const Note* note : notes) {
+                matches += noteHasTag(note, "gym");
             }
+        }, minSeconds);
+        streambuf* console = cout.rdbuf(&discard);
+        measureScaling(curves[7], items, []() {}, [&]() {
+            for (const Item* item : store->snapshot()) {
+                item->display();
+            }
+        }, minSeconds);
+        cout.rdbuf(console);
+        benchSink = benchSink + matches;
+
+        cout << "  " << setw(9) << items << " items:";
+        for (const ScalingCurve& curve : curves) {
+            cout << " " << curve.operation << " " << formatLatency(static_cast<uint64_t>(curve.seconds.back() * 1e9)) << ";";
+        }
+        cout << endl;
+    }
+    remove(dataFile.c_str());
+    if (curves[0].items.size() < 2) {
+        cout << "At least two sizes (max items of 10000 or more) are needed to fit exponents." << endl;
+        return;
+    }
+
+    cout << "\n" << left << setw(22) << "Operation" << right << setw(10) << "expected" << setw(10) << "fitted" << setw(12) << "last step"
+        << setw(14) << "ns/item (max)" << setw(14) << "allocs/item" << "  flags\n" << fixed;
+    for (ScalingCurve& curve : curves) {
+        fitScalingCurve(curve);
+        double items = static_cast<double>(curve.items.back());
+        cout << left << setw(22) << curve.operation << right << setw(10) << curve.expected << setprecision(2) << setw(10) << curve.exponent
+            << setw(12) << curve.lastStepExponent << setprecision(1) << setw(14) << curve.seconds.back() * 1e9 / items << setw(14) << static_cast<double>(curve.allocations.back()) / items << "  ";
+        for (size_t i = 0; i < curve.flags.size(); i++) {
+            cout << (i ? "; " : "") << curve.flags[i];
         }
+        cout << (curve.flags.empty() ? "ok\n" : "\n");
+    }
+    cout << left;
 
-        switch (noteChoice) {
-        case 1:
-            cout << "All Notes:\n\n";
-            for (auto& note : notes) {
-                note->display();
-                cout << endl;
+    if (!csvFile.empty()) {
+        ofstream csv(csvFile);
+        csv << "operation,items,seconds,ns_per_item,allocations\n" << setprecision(9);
+        for (const ScalingCurve& curve : curves) {
+            for (size_t i = 0; i < curve.items.size(); i++) {
+                csv << curve.operation << "," << curve.items[i] << "," << curve.seconds[i] << "," << curve.seconds[i] * 1e9 / curve.items[i] << "," << curve.allocations[i] << "\n";
             }
-            break;
-        case 2:  // Now this will only display details for generic notes
-            cout << "\tGeneric Notes Details:\n\n";
-            for (auto& note : notes) {
-                if (note != nullptr && dynamic_cast<ProtectedNote*>(note) == nullptr && dynamic_cast<PublicNote*>(note) == nullptr) {
-                    cout << note->getDetails() << endl << endl;
-                }
-                else if (note == nullptr) {
-                    cout << "Note is null and cannot be displayed.\n";
-                }
+        }
+        cout << (csv ? "Curves written to " : "Could not write ") << csvFile << endl;
+    }
+    if (!jsonFile.empty()) {
+        ofstream json(jsonFile);
+        json << "{\n  \"operations\": [";
+        for (size_t c = 0; c < curves.size(); c++) {
+            const ScalingCurve& curve = curves[c];
+            json << (c ? "," : "") << "\n    {\n      \"name\": \"" << curve.operation << "\",\n      \"expected\": \"" << curve.expected << "\",\n"
+                << setprecision(4) << "      \"fitted_exponent\": " << curve.exponent << ",\n      \"expected_exponent\": " << curve.expectedExponent
+                << ",\n      \"last_step_exponent\": " << curve.lastStepExponent << ",\n      \"flags\": [";
+            for (size_t i = 0; i < curve.flags.size(); i++) {
+                json << (i ? ", " : "") << "\"" << curve.flags[i] << "\"";
             }
-            break;
-        case 3: {
-            cout << "\tProtected Notes Details:\n\n";
-            bool accessGranted = false;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer just in case
+            json << "],\n      \"points\": [";
+            for (size_t i = 0; i < curve.items.size(); i++) {
+                json << (i ? ", " : "") << "{\"items\": " << curve.items[i] << setprecision(9) << ", \"seconds\": " << curve.seconds[i]
+                    << ", \"allocations\": " << curve.allocations[i] << "}";
+            }
+            json << "]\n    }";
+        }
+        json << "\n  ]\n}\n";
+        cout << (json ? "Curves written to " : "Could not write ") << jsonFile << endl;
+    }
+}
 
-            for (auto& note : notes) {
-                ProtectedNote* protectedNote = dynamic_cast<ProtectedNote*>(note);
-                if (protectedNote) {
-                    cout << "\nEnter password to view " << protectedNote->title << "(HINT: password123 for Personal Diary, if you want to access other protected notes you've created please press ENTER): ";
-                    string passwordInput;
-                    getline(cin, passwordInput);
+// Index used by the insertion benchmark: tasks ordered by priority
+class PriorityBenchIndex : public ItemIndex {
+public:
+    void onInsert(Item* item) override {
+        if (Task* task = dynamic_cast<Task*>(item)) {
+            lock_guard<mutex> lock(indexMutex);
+            byPriority.insert(make_pair(task->priority, task));
+        }
+    }
+
+    // Sorts the batch first so every insert lands at the hinted position
+    void onInsertBatch(const vector<Item*>& items) override {
+        vector<pair<int, Task*>> entries;
+        entries.reserve(items.size());
+        for (Item* item : items) {
+            if (Task* task = dynamic_cast<Task*>(item)) {
+                entries.push_back(make_pair(task->priority, task));
+            }
+        }
+        stable_sort(entries.begin(), entries.end(), [](const pair<int, Task*>& a, const pair<int, Task*>& b) { return a.first < b.first; });
+        lock_guard<mutex> lock(indexMutex);
+        for (auto& entry : entries) {
+            byPriority.insert(byPriority.upper_bound(entry.first), entry);
+        }
+    }
+
+    size_t size() const {
+        return byPriority.size();
+    }
+
+private:
+    mutex indexMutex;
+    multimap<int, Task*> byPriority;
+};
+
+// Compares add() per item against addBatch() in chunks, with and without an attached index
+void benchmarkBatchInsert(size_t itemCount, size_t batchSize) {
+    cout << "Inserting " << itemCount << " items (batch size " << batchSize << ")\n";
+    cout << left << setw(28) << "mode" << "inserts/s\n" << right;
+    for (int withIndex = 0; withIndex < 2; withIndex++) {
+        for (int batched = 0; batched < 2; batched++) {
+            vector<Item*> items = generateSampleItems(itemCount, 3);
+            size_t taskCount = count_if(items.begin(), items.end(), [](Item* item) { return dynamic_cast<Task*>(item) != nullptr; });
+            ItemStore store;
+            PriorityBenchIndex index;
+            if (withIndex) {
+                store.attachIndex(&index);
+            }
 
-                    if (passwordInput == protectedNote->password) {
-                        cout << "\nAccess granted to: " << protectedNote->title << "\n";
-                        cout << protectedNote->getDetails() << endl << endl;
-                        accessGranted = true;
-                        break;
-                    }
-                    else {
-                        cout << "Incorrect password. Try again for this note.\n";
-                    }
+            auto start = chrono::steady_clock::now();
+            if (batched) {
+                for (size_t i = 0; i < items.size(); i += batchSize) {
+                    vector<Item*> batch(items.begin() + i, items.begin() + min(items.size(), i + batchSize));
+                    store.addBatch(batch);
                 }
             }
+            else {
+                for (Item* item : items) {
+                    store.add(item);
+                }
+            }
+            double elapsed = secondsSince(start);
 
-            if (!accessGranted) {
-                cout << "\nNo access granted to any protected notes with given passwords.\n";
+            string mode = string(batched ? "addBatch" : "add") + (withIndex ? " + priority index" : "");
+            cout << left << setw(28) << mode << right << fixed << setprecision(0) << itemCount / elapsed << "\n";
+            if (store.size() != itemCount || (withIndex && index.size() != taskCount)) {
+                cout << "  unexpected item count after insertion\n";
             }
-            break;
         }
-        case 4:
-            cout << "\tUnprotected Notes Details:\n\n";
-            for (auto& note : notes) {
-                if (PublicNote* publicNote = dynamic_cast<PublicNote*>(note)) {
-                    cout << publicNote->getDetails() << endl << endl;
+    }
+}
+
+// Item creation throughput and producer-side latency for 1, 2, 4 and 8 producer threads:
+// the lock-free ingestion queue against producers calling store.add() behind one mutex
+void benchmarkIngestion(size_t itemsPerProducer) {
+    cout << "Ingesting " << itemsPerProducer << " items per producer into a store with a priority index\n";
+    cout << left << setw(11) << "producers" << setw(10) << "mode" << setw(16) << "items/s" << "push latency p50 / p99 / max (ns)\n" << right;
+    for (unsigned producers = 1; producers <= 8; producers *= 2) {
+        for (int useQueue = 1; useQueue >= 0; useQueue--) {
+            vector<vector<Item*>> work(producers);
+            for (unsigned p = 0; p < producers; p++) {
+                work[p] = generateSampleItems(itemsPerProducer, 100 + p);
+            }
+            vector<vector<double>> latencies(producers, vector<double>(itemsPerProducer));
+            ItemStore store;
+            PriorityBenchIndex index;
+            store.attachIndex(&index);
+            mutex storeMutex; // Baseline: every producer serializes on this lock
+
+            auto start = chrono::steady_clock::now();
+            {
+                unique_ptr<ItemIngestor> ingestor(useQueue ? new ItemIngestor(store) : nullptr);
+                vector<thread> threads;
+                for (unsigned p = 0; p < producers; p++) {
+                    threads.emplace_back([&, p]() {
+                        for (size_t i = 0; i < itemsPerProducer; i++) {
+                            auto before = chrono::steady_clock::now();
+                            if (ingestor) {
+                                ingestor->submit(work[p][i]);
+                            }
+                            else {
+                                lock_guard<mutex> lock(storeMutex);
+                                store.add(work[p][i]);
+                            }
+                            latencies[p][i] = chrono::duration<double, nano>(chrono::steady_clock::now() - before).count();
+                        }
+                    });
+                }
+                for (auto& th : threads) {
+                    th.join();
+                }
+                if (ingestor) {
+                    ingestor->flush(); // Throughput counts until the items are actually in the store
                 }
             }
-            break;
-        case 5:
-        {
-            string searchText;
-            cout << "\nEnter search text: ";
-            cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            getline(cin, searchText);
-            searchNotesFullText(notes, searchText);
-        }
-        break;
-        case 6:
-        {
-            string tag;
-            cout << "\nEnter tag to search: ";
-            cin >> tag;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear any excess input
-            searchNotesByTag(notes, tag);
-        }
-        break;
-        case 7:
-            return; // Exit the loop and return to the main menu
-        default:
-            cout << "Invalid choice, please choose again.\n";
+            double elapsed = secondsSince(start);
+
+            vector<double> all;
+            for (auto& producerLatencies : latencies) {
+                all.insert(all.end(), producerLatencies.begin(), producerLatencies.end());
+            }
+            sort(all.begin(), all.end());
+            cout << left << setw(11) << producers << setw(10) << (useQueue ? "queue" : "mutex") << right << fixed << setprecision(0)
+                << setw(12) << all.size() / elapsed << "    " << all[all.size() / 2] << " / " << all[all.size() * 99 / 100] << " / " << all.back() << "\n";
+            if (store.size() != all.size()) {
+                cout << "  unexpected item count after ingestion\n";
+            }
         }
-    } while (noteChoice != 7); // Keep looping until 'Go Back' is selected
+    }
 }
 
-void addTask(vector<Item*>& items) {
-    string title, description, deadline, interval;
-    int priority, type;
-    cout << "Enter task type (1 for One-Time, 2 for Recurring, 3 for Generic): ";
-    if (!(cin >> type)) {
-        cin.clear(); // Clear error state
-        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
-        cout << "Invalid input. Please enter a valid number. Press ENTER to continue." << endl;
-        return; // Exit the function on invalid input
+// Runs a non-interactive command given on the command line, e.g. "bench store" or "stress store"
+int runBatchCommand(const vector<string>& args) {
+    if (args.size() >= 2 && args[0] == "stress" && args[1] == "store") {
+        int threads = max(2, static_cast<int>(thread::hardware_concurrency()));
+        bool ok = stressItemStore(threads, threads, 20000);
+        cout << "ItemStore stress test (" << threads << " writers, " << threads << " readers): " << (ok ? "PASSED" : "FAILED") << endl;
+        return ok ? 0 : 1;
     }
-    cin.ignore(); // Clear the newline left by cin >>
-
-    cout << "Enter task title: ";
-    getline(cin, title);
-    cout << "Enter description: ";
-    getline(cin, description);
-    cout << "Enter deadline (YYYY-MM-DD or No Deadline): ";
-    getline(cin, deadline);
-    cout << "Enter priority (1-10): ";
-    if (!(cin >> priority)) {
-        cin.clear(); // Clear error state
-        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore incorrect input
-        cout << "Invalid input. Please enter a valid number. Press ENTER to continue." << endl;
-        return; // Exit the function on invalid input
+    if (args.size() >= 2 && args[0] == "stress" && args[1] == "checkpoint") {
+        bool ok = stressCheckpoint(args.size() >= 3 ? stoul(args[2]) : 50000, args.size() >= 4 ? stod(args[3]) : 5.0);
+        cout << "Checkpoint stress test (progress updates during saves): " << (ok ? "PASSED" : "FAILED") << endl;
+        return ok ? 0 : 1;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "store") {
+        double seconds = args.size() >= 3 ? stod(args[2]) : 2.0;
+        benchmarkItemStore(20000, seconds);
+        return 0;
     }
-    cin.ignore(); // Clear the newline left by cin >>
 
-    if (type == 2) { // Recurring Task
-        cout << "Enter recurrence interval (e.g., weekly, monthly): ";
-        getline(cin, interval);
-        RecurringTask* newTask = new RecurringTask(title, description, deadline, priority, interval);
-        items.push_back(newTask);
-        cout << "Recurring Task added successfully! Press ENTER to continue!\n";
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "insert") {
+        benchmarkBatchInsert(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? stoul(args[3]) : 4096);
+        return 0;
     }
-    else if (type == 1) { // One-Time Task
-        OneTimeTask* newTask = new OneTimeTask(title, description, deadline, priority);
-        items.push_back(newTask);
-        cout << "One-Time Task added successfully! Press ENTER to continue!\n";
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "ingest") {
+        benchmarkIngestion(args.size() >= 3 ? stoul(args[2]) : 200000);
+        return 0;
     }
-    else { // Generic Task
-        Task* newTask = new Task(title, description, deadline, priority);
-        items.push_back(newTask);
-        cout << "Generic Task added successfully! Press ENTER to continue!\n";
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "checkpoint") {
+        benchmarkCheckpoint(args.size() >= 3 ? stoul(args[2]) : 10000000, args.size() >= 4 ? args[3] : "bench_data.txt");
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "segments") {
+        benchmarkSegmentedSave(args.size() >= 3 ? args[2] : "bench_segments");
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "save") {
+        benchmarkSave(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? args[3] : "bench_data.txt");
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "load") {
+        benchmarkLoadSave(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? args[3] : "bench_data.txt");
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "mmap") {
+#ifndef _WIN32
+        benchmarkMappedStartup(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? args[3] : "bench_data.txt");
+        return 0;
+#else
+        cout << "The memory-mapped store requires a POSIX system." << endl;
+        return 1;
+#endif
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "recurrence") {
+        benchmarkRecurrence(args.size() >= 3 ? stoul(args[2]) : 2000000);
+        return 0;
+    }
+    if (args.size() >= 3 && args[0] == "occurrences") {
+        return listOccurrences(args[1], args[2], args.size() >= 4 ? args[3] : "data.txt");
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "reminders") {
+        benchmarkReminders(args.size() >= 3 ? stoul(args[2]) : 2000000);
+        return 0;
+    }
+    if (!args.empty() && args[0] == "reminders") {
+        return listReminders(args.size() >= 2 ? args[1] : "data.txt", args.size() >= 3 ? stoi(args[2]) : 7, args.size() >= 4 ? stoi(args[3]) : 1);
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "due") {
+        benchmarkDueDates(args.size() >= 3 ? stoul(args[2]) : 1000000);
+        return 0;
+    }
+    if (args.size() >= 3 && args[0] == "due") {
+        return listDueTasks(args[1], args[2], args.size() >= 4 ? args[3] : "data.txt");
+    }
+    if (!args.empty() && args[0] == "overdue") {
+        ItemStore store;
+        DueDateIndex dueDates;
+        store.attachIndex(&dueDates);
+        loadDataFromFile(args.size() >= 2 ? args[1] : "data.txt", store);
+        displayDueItems(dueDates.overdue(currentDay()));
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "progress") {
+        benchmarkProgressHistory(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? stoul(args[3]) : 52);
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "dashboard") {
+        benchmarkDashboard(args.size() >= 3 ? stoul(args[2]) : 1000000);
+        return 0;
+    }
+    if (!args.empty() && args[0] == "dashboard") {
+        ItemStore store;
+        DashboardAggregates dashboard;
+        store.attachIndex(&dashboard);
+        loadDataFromFile(args.size() >= 2 ? args[1] : "data.txt", store);
+        dashboard.display(currentDay());
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "goaltree") {
+        benchmarkGoalTree(args.size() >= 3 ? stoul(args[2]) : 1000000);
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "notes") {
+        benchmarkProtectedNotes(args.size() >= 3 ? stoul(args[2]) : 100, args.size() >= 4 ? args[3] : "bench_notes.txt");
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "algorithms") {
+        bool written = benchmarkAlgorithms(args.size() >= 3 && args[2] != "-" ? args[2] : "", args.size() >= 4 && args[3] != "-" ? args[3] : "",
+            args.size() >= 5 ? stod(args[4]) : 0.1, args.size() >= 6 ? stoi(args[5]) : 1);
+        return written ? 0 : 1;
+    }
+    if (args.size() >= 4 && args[0] == "bench" && args[1] == "compare" && args[2] == "--record") {
+        bool written = benchmarkAlgorithms(args[3], args.size() >= 5 && args[4] != "-" ? args[4] : "", args.size() >= 6 && args[5] != "-" ? stod(args[5]) : 0.05,
+            args.size() >= 7 && args[6] != "-" ? stoi(args[6]) : 5);
+        return written ? 0 : 1;
+    }
+    if (args.size() >= 3 && args[0] == "bench" && args[1] == "compare") {
+        bool passed = compareWithBaseline(args[2], args.size() >= 4 && args[3] != "-" ? args[3] : "", args.size() >= 5 && args[4] != "-" ? stod(args[4]) : 0.05,
+            args.size() >= 6 && args[5] != "-" ? stoi(args[5]) : 5, args.size() >= 7 && args[6] != "-" ? stod(args[6]) : 10.0, args.size() >= 8 ? args[7] : "");
+        return passed ? 0 : 1;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "stats") {
+        benchmarkLatencyStats(args.size() >= 3 ? stoul(args[2]) : 10000000);
+        return 0;
+    }
+    if (!args.empty() && args[0] == "memory") {
+        ItemStore store;
+        loadDataFromFile(args.size() >= 2 ? args[1] : "data.txt", store);
+        MemoryReport(store).display();
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "bench" && args[1] == "scaling") {
+        benchmarkScaling(args.size() >= 3 ? stoul(args[2]) : 10000000, args.size() >= 4 && args[3] != "-" ? args[3] : (args.size() >= 4 ? "" : "scaling.csv"),
+            args.size() >= 5 && args[4] != "-" ? args[4] : (args.size() >= 5 ? "" : "scaling.json"));
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "alloc" && args[1] == "budgets") {
+        return checkAllocationBudgets(args.size() >= 3 ? stoul(args[2]) : 10000);
+    }
+    if (!args.empty() && args[0] == "trace") {
+        runSampleSession(args.size() >= 3 ? args[2] : "data.txt");
+        return exportTrace(args.size() >= 2 ? args[1] : "gtn_trace.json") ? 0 : 1;
+    }
+    if (!args.empty() && args[0] == "perf") {
+        perfProfiling = true;
+        runSampleSession(args.size() >= 2 ? args[1] : "data.txt");
+        showLatencyStats();
+        return 0;
+    }
+    if (args.size() >= 2 && args[0] == "mmap") {
+#ifndef _WIN32
+        return runMappedCommand(args);
+#else
+        cout << "The memory-mapped store requires a POSIX system." << endl;
+        return 1;
+#endif
+    }
+    if (args.size() >= 3 && args[0] == "generate") {
+        ofstream out(args[2]);
+        for (Item* item : generateSampleItems(stoul(args[1]), 42)) {
+            out << item->getRecord() << "\n";
+            delete item;
+        }
+        return out ? 0 : 1;
+    }
+    if (!args.empty() && args[0] == "serve") {
+#ifdef __linux__
+        ItemStore store;
+        string dataFile = args.size() >= 3 ? args[2] : "data.txt";
+        unsigned workers = args.size() >= 4 ? stoul(args[3]) : max(1u, thread::hardware_concurrency());
+        loadDataPipelined(dataFile, store, max(2u, workers)); // Load once, then serve from memory
+        size_t loadedChanges = store.changeCount();
+        // Block SIGINT/SIGTERM before the checkpointer thread starts, so it inherits the mask and the
+        // signals reach runServer's signalfd instead of killing the process before the final save
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+        int result;
+        {
+            // Items added over the socket are saved in the background, as in the interactive mode
+            Checkpointer checkpointer(store, [&]() { return saveDataToFile(dataFile, store); }, 60, 100);
+            result = runServer(store, args.size() >= 2 ? args[1] : "/tmp/gtn.sock", workers);
+        }
+        if (store.changeCount() != loadedChanges && !saveDataToFile(dataFile, store)) {
+            cout << "Warning: could not save " << dataFile << ", the previous file was kept." << endl;
+            return 1;
+        }
+        return result;
+#else
+        cout << "Server mode requires Linux (epoll and Unix domain sockets)." << endl;
+        return 1;
+#endif
+    }
+    if (!args.empty() && args[0] == "loadgen") {
+#ifdef __linux__
+        runLoadGenerator(args.size() >= 2 ? args[1] : "/tmp/gtn.sock", args.size() >= 3 ? stoul(args[2]) : 8, args.size() >= 4 ? stoul(args[3]) : 2000);
+        return 0;
+#else
+        cout << "The load generator requires Linux (Unix domain sockets)." << endl;
+        return 1;
+#endif
     }
-}
-
-
-
-
 
-void addGoal(vector<Item*>& items) {
-    string title, description;
-    double progress = 0.0; // Initialize progress with a default value
-    int type;
-    cout << "Enter goal type (1 for Quantifiable, 2 for Non-Quantifiable, 3 for Generic): ";
-    cin >> type;
-    cin.ignore(); // Consume the remaining newline character
+    cout << "Usage:\n"
+        << "  (no arguments)        start the interactive menu\n"
+        << "  --checkpoint-interval <secs> --checkpoint-dirty <items>\n"
+        << "                        interactive menu with background saves every <secs> seconds or\n"
+        << "                        after <items> changes (defaults 60 and 100)\n"
+        << "  --segments <dir>      interactive menu storing data as segments in <dir>, saving only\n"
+        << "                        changed segments (imports data.txt on first use)\n"
+        << "  --reminder-days <n>   remind about tasks due within <n> days (default 1)\n"
+        << "  --track-allocations   count heap allocations per operation (shown with the latency statistics)\n"
+        << "  --perf-counters       read cycles, instructions, cache and branch misses per operation (Linux)\n"
+        << "  --record <session>    log every menu input with a timestamp to <session> for replay\n"
+        << "                        (owner-only file; note passwords are replaced by a marker)\n"
+        << "  replay <session> [data] [timings csv] [--replay-password <password>]\n"
+        << "                        replay a recorded session against a copy of a data file as fast as\n"
+        << "                        possible and report the time spent on each input and operation;\n"
+        << "                        recorded passwords become <password>, or fail to unlock without it\n"
+        << "  stress store          run the ItemStore concurrency stress test\n"
+        << "  stress checkpoint [goals] [secs]\n"
+        << "                        update goal progress while saving in a loop; build with\n"
+        << "                        -fsanitize=thread to check the saves for data races\n"
+        << "  bench store [secs]    measure ItemStore read/write throughput across cores\n"
+        << "  bench insert [count] [batch]\n"
+        << "                        compare single-item and batch insertion rates\n"
+        << "  bench ingest [items per producer]\n"
+        << "                        compare the lock-free ingestion queue with a mutex-guarded add\n"
+        << "  bench checkpoint [count] [file]\n"
+        << "                        measure the interactive pause during a background checkpoint\n"
+        << "  bench segments [dir]  compare full and incremental (segmented) saves\n"
+        << "  bench save [count] [file]\n"
+        << "                        measure save throughput in GB/s\n"
+        << "  bench load [count] [file]\n"
+        << "                        compare sequential and pipelined load/save (cold cache on Linux)\n"
+        << "  bench mmap [count] [file]\n"
+        << "                        compare startup of the memory-mapped store with loading data.txt\n"
+        << "  bench recurrence [count]\n"
+        << "                        measure next-occurrence lookup and window expansion of recurring tasks\n"
+        << "  occurrences <from> <to> [data]\n"
+        << "                        list the occurrences of each recurring task between two dates\n"
+        << "  bench reminders [count]\n"
+        << "                        measure deadline timer wheel insert and fire throughput\n"
+        << "  reminders [data] [days] [lead]\n"
+        << "                        print the deadline reminders of the next <days> days (default 7)\n"
+        << "  bench due [count]     compare date-range queries on the due-date index with sort + scan\n"
+        << "  due <from> <to> [data]\n"
+        << "                        list tasks and recurring occurrences due in a date range (- = open)\n"
+        << "  overdue [data]        list tasks whose deadline has passed\n"
+        << "  bench progress [goals] [updates]\n"
+        << "                        measure memory, range reads and weekly downsampling of progress history\n"
+        << "  bench dashboard [count]\n"
+        << "                        compare the maintained dashboard aggregates with a full scan\n"
+        << "  dashboard [data]      print item counts, priorities, goal progress, tags and deadlines\n"
+        << "  bench goaltree [count]\n"
+        << "                        measure sub-goal linking and progress roll-up on wide and deep trees\n"
+        << "  bench notes [count] [file]\n"
+        << "                        measure loading and unlocking encrypted protected notes\n"
+        << "  bench algorithms [json] [filter] [min secs] [repetitions]\n"
+        << "                        microbenchmarks of the sorts, KMP search, split, toLowerCase and the\n"
+        << "                        loader on sorted/reversed/random/duplicate inputs; optional JSON\n"
+        << "                        results in Google Benchmark format (- skips an argument)\n"
+        << "  bench compare <baseline> [filter] [min secs] [repetitions] [threshold %] [results json]\n"
+        << "                        run the algorithm benchmarks (default 5 repetitions) and fail when the\n"
+        << "                        median of one is slower than the baseline JSON beyond the threshold\n"
+        << "                        (default 10%) with 95% confidence; fails if the baseline is unreadable\n"
+        << "  bench compare --record <baseline> [filter] [min secs] [repetitions]\n"
+        << "                        run the same benchmarks and write their results as the baseline\n"
+        << "  bench stats [count]   measure the overhead of the latency timers and trace spans\n"
+        << "  bench scaling [max items] [csv] [json]\n"
+        << "                        time load, save, sorts, searches and display from 1000 to max items\n"
+        << "                        (default 10^7), fit complexity exponents and flag super-linear growth;\n"
+        << "                        curves go to scaling.csv and scaling.json (- skips a file)\n"
+        << "  memory [data]         report the memory used by each item type, split by field\n"
+        << "  perf [data]           run the trace session with performance counters and print them per operation\n"
+        << "  alloc budgets [count] check the heap allocations of common operations against their budgets\n"
+        << "  trace [out] [data]    load, sort, search, render and save the data file, and write the\n"
+        << "                        execution spans as Chrome trace JSON (default gtn_trace.json)\n"
+        << "  mmap import <store> [data]\n"
+        << "                        append the items of a data file to a memory-mapped store file\n"
+        << "  mmap list <store>     list the items of a memory-mapped store\n"
+        << "  mmap set-priority <store> <index> <priority>\n"
+        << "  mmap set-progress <store> <index> <progress>\n"
+        << "                        update a task or goal in place (POSIX only)\n"
+        << "  generate <count> <file>\n"
+        << "                        write a data file of generated sample items\n"
+        << "  serve [socket] [data] [workers]\n"
+        << "                        load the data file once and serve requests over a Unix socket;\n"
+        << "                        added items are checkpointed and saved on shutdown\n"
+        << "  loadgen [socket] [clients] [requests]\n"
+        << "                        measure server requests/s and latency percentiles\n";
+    return 1;
+}
 
-    cout << "Enter goal title: ";
-    getline(cin, title);
-    cout << "Enter description: ";
-    getline(cin, description);
 
-    if (type == 1) { // Quantifiable Goal
-        cout << "Enter progress (0.0 - 1.0): ";
-        cin >> progress;
-        QuantifiableGoal* newGoal = new QuantifiableGoal(title, description, progress);
-        items.push_back(newGoal);
-        cout << "Quantifiable Goal added successfully!" << endl;
-    }
-    else if (type == 2) { // Non-Quantifiable Goal
-        NonQuantifiableGoal* newGoal = new NonQuantifiableGoal(title, description, progress); // Default progress as 0
-        items.push_back(newGoal);
-        cout << "Non-Quantifiable Goal added successfully! Press ENTER to continue!" << endl;
+// Main function
+// Records every line read from cin, with the milliseconds since recording started, in a session
+// file that "replay" feeds back. The first line lists the options the session was started with.
+// Passwords (lines read with readSecretLine) are logged as "<ms>*" with no input. On POSIX the file
+// is readable only by its owner.
+class SessionRecorder : public streambuf {
+public:
+    SessionRecorder(const string& filename, const vector<string>& options) : source(cin.rdbuf()), start(chrono::steady_clock::now()) {
+#ifndef _WIN32
+        int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0600);
+        if (fd >= 0) {
+            fchmod(fd, 0600); // Also when the file existed with wider permissions
+            ::close(fd);
+        }
+#endif
+        log.open(filename, ios::trunc);
+        log << "#";
+        for (const string& option : options) {
+            log << " " << option;
+        }
+        log << "\n" << flush;
+        cin.rdbuf(this);
     }
-    else { // Generic Goal
-        cout << "Enter progress (0.0 - 1.0, enter 0 if progress does not apply): ";
-        cin >> progress;
-        Goal* newGoal = new Goal(title, description, progress);
-        items.push_back(newGoal);
-        cout << "Generic Goal added successfully!" << endl;
+
+    ~SessionRecorder() {
+        cin.rdbuf(source);
     }
-}
 
+    bool isOpen() const {
+        return static_cast<bool>(log);
+    }
 
+protected:
+    int underflow() override {
+        line.clear();
+        int c;
+        while ((c = source->sbumpc()) != traits_type::eof()) {
+            line += static_cast<char>(c);
+            if (c == '\n') {
+                break;
+            }
+        }
+        if (line.empty()) {
+            return traits_type::eof();
+        }
+        string input = line.back() == '\n' ? line.substr(0, line.size() - 1) : line;
+        log << static_cast<uint64_t>(secondsSince(start) * 1000) << (readingSecretInput ? "*\t" : "\t" + input) << "\n" << flush; // Flushed so a crashed session is kept
+        setg(&line[0], &line[0], &line[0] + line.size());
+        return traits_type::to_int_type(line[0]);
+    }
 
+private:
+    ofstream log;
+    streambuf* source;
+    chrono::steady_clock::time_point start;
+    string line;
+};
 
-void addNote(vector<Item*>& items) {
-    string title, description, tagsInput, password;
-    vector<string> tags;
-    int type;
-    cout << "Enter note type (1 for Public, 2 for Protected, 3 for Generic): ";
-    cin >> type;
-    cin.ignore(); // Important to consume the newline character after cin
+// Feeds the inputs of a recorded session to cin one line at a time. The time from handing out one
+// line until the next is requested is the time the program spent acting on it.
+class ReplayBuffer : public streambuf {
+public:
+    struct Input {
+        uint64_t recordedMs;
+        string text;
+        bool redacted;      // A password that was not recorded; text is the replay password
+        double seconds = 0; // Time spent acting on the input during the replay
+    };
 
-    cout << "Enter note title: ";
-    getline(cin, title);
-    cout << "Enter description: ";
-    getline(cin, description);
-    cout << "Enter tags (comma-separated): ";
-    getline(cin, tagsInput);
+    ReplayBuffer(const vector<Input>& inputs) : inputs(inputs), next(0) {}
 
-    stringstream ss(tagsInput);
-    string tag;
-    while (getline(ss, tag, ',')) {
-        tag = tag.empty() ? "generic" : tag; // Ensure no empty tags; use 'generic' as a placeholder if empty
-        tags.push_back(tag);
-    }
-    if (type == 2) { // Protected Note
-        cout << "Enter password for protected note: ";
-        getline(cin, password);
-        ProtectedNote* newNote = new ProtectedNote(title, description, tags, password);
-        items.push_back(newNote);
-        cout << "Protected Note added successfully! Press ENTER to continue!" << endl;
+    // Closes the timing of the last input handed out (the program exited without reading further)
+    void finish() {
+        if (next > 0 && inputs[next - 1].seconds == 0) {
+            inputs[next - 1].seconds = secondsSince(handedOut);
+        }
     }
-    else if (type == 1) { // Public Note
-        PublicNote* newNote = new PublicNote(title, description, tags);
-        items.push_back(newNote);
-        cout << "Public Note added successfully! Press ENTER to continue!" << endl;
+
+    const vector<Input>& getInputs() const {
+        return inputs;
     }
-    else if (type == 3) { // Generic Note
-        Note* newNote = new Note(title, description, tags); // Generic notes can use the base class Note
-        items.push_back(newNote);
-        cout << "Generic Note added successfully! Press ENTER to continue!" << endl;
+
+protected:
+    int underflow() override {
+        finish();
+        if (next == inputs.size()) {
+            return traits_type::eof();
+        }
+        line = inputs[next++].text + "\n";
+        setg(&line[0], &line[0], &line[0] + line.size());
+        handedOut = chrono::steady_clock::now();
+        return traits_type::to_int_type(line[0]);
     }
-}
 
+private:
+    vector<Input> inputs;
+    size_t next;
+    string line;
+    chrono::steady_clock::time_point handedOut;
+};
 
+// The interactive menu; args are the -- options
+int runInteractive(const vector<string>& args) {
+    // Options of the interactive mode
+    double checkpointInterval = 60;
+    size_t checkpointDirty = 100;
+    string segmentDirectory; // Empty: keep everything in data.txt
+    int reminderDays = 1;
+    unique_ptr<AllocationTracking> allocationTracking;
+    unique_ptr<SessionRecorder> recorder;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i] == "--track-allocations") {
+            allocationTracking.reset(new AllocationTracking());
+            continue;
+        }
+        if (args[i] == "--perf-counters") {
+            perfProfiling = true;
+            continue;
+        }
+        if (i + 1 == args.size()) {
+            return runBatchCommand(vector<string>()); // Option without a value: print usage
+        }
+        const string& value = args[++i];
+        if (args[i - 1] == "--checkpoint-interval") {
+            checkpointInterval = stod(value);
+        }
+        else if (args[i - 1] == "--checkpoint-dirty") {
+            checkpointDirty = stoul(value);
+        }
+        else if (args[i - 1] == "--segments") {
+            segmentDirectory = value;
+        }
+        else if (args[i - 1] == "--reminder-days") {
+            reminderDays = stoi(value);
+        }
+        else if (args[i - 1] == "--record") {
+            vector<string> options;
+            for (size_t j = 0; j < args.size(); j++) {
+                if (args[j] == "--record") {
+                    j++; // A replay must not record over the session
+                    continue;
+                }
+                options.push_back(args[j]);
+            }
+            recorder.reset(new SessionRecorder(value, options));
+            if (!recorder->isOpen()) {
+                cout << "Error: could not create the session file " << value << endl;
+                return 1;
+            }
+            cout << "Warning: recording every input to " << value << ". Passwords are replaced by a marker, but titles,\n"
+                << "descriptions and search terms are stored as typed; review the file before sharing it." << endl;
+        }
+        else {
+            return runBatchCommand(vector<string>());
+        }
+    }
 
-// Main function
-int main() {
-    vector<Item*> items;
-    loadDataFromFile("data.txt", items); // Load existing data
+    unique_ptr<SegmentedStorage> segments(segmentDirectory.empty() ? nullptr : new SegmentedStorage(segmentDirectory));
+    ItemStore store;
+    ProgressHistory history;
+    history.load("progress_history.txt");
+    GoalTree goalTree;
+    function<bool()> save;
+    if (segments) {
+        segments->load(store, "data.txt"); // Falls back to importing data.txt the first time
+        save = [&]() { return segments->save(store) && history.save("progress_history.txt") && goalTree.save("goal_tree.txt", store); };
+    }
+    else {
+        loadDataFromFile("data.txt", store); // Load existing data
+        save = [&]() { return saveDataToFile("data.txt", store) && history.save("progress_history.txt") && goalTree.save("goal_tree.txt", store); };
+    }
+    goalTree.load("goal_tree.txt", store);
+    unique_ptr<Checkpointer> checkpointer(new Checkpointer(store, save, checkpointInterval, checkpointDirty));
+    DeadlineWheel reminders(currentDay(), reminderDays);
+    store.attachIndex(&reminders);
+    DueDateIndex dueDates;
+    store.attachIndex(&dueDates);
+    DashboardAggregates dashboard;
+    store.attachIndex(&dashboard);
 
     int choice;
     do {
+        showReminders(reminders);
         cout << "-----------------------------------------\n";
         cout << "\tWelcome to GTN Manager!\n\n";
         cout << "1. Display All Items\n";
@@ -973,10 +8039,16 @@ int main() {
         cout << "5. Add New Task\n";
         cout << "6. Add New Goal\n";
         cout << "7. Add New Note\n";
-        cout << "8. Exit\n";
+        cout << "8. Dashboard\n";
+        cout << "9. Latency statistics\n";
+        cout << "10. Export execution trace\n";
+        cout << "11. Exit\n";
         cout << "-----------------------------------------\n";
 
         if (!(cin >> choice)) {
+            if (cin.eof()) {
+                break; // End of input (Ctrl+D or the end of a replayed session): save and exit
+            }
             cin.clear(); // Clear error state
             cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard the input
             cout << "Invalid input. Please enter a number.\n";
@@ -985,27 +8057,44 @@ int main() {
 
         switch (choice) {
         case 1:
-            displayAllItems(items);
+            displayAllItems(store);
             break;
         case 2:
-            handleTasks(items);
+            handleTasks(store, dueDates);
             break;
         case 3:
-            handleGoals(items);
+            handleGoals(store, history, goalTree);
             break;
         case 4:
-            handleNotes(items);
+            handleNotes(store);
             break;
         case 5:
-            addTask(items);
+            addTask(store);
             break;
         case 6:
-            addGoal(items);
+            addGoal(store);
             break;
         case 7:
-            addNote(items);
+            addNote(store);
+            break;
+        case 8: {
+            TIME_OPERATION("dashboard");
+            dashboard.display(currentDay());
+            break;
+        }
+        case 9:
+            showLatencyStats();
+            break;
+        case 10: {
+            string traceFile;
+            cout << "Enter trace file name (ENTER for gtn_trace.json): ";
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            getline(cin, traceFile);
+            exportTrace(traceFile.empty() ? "gtn_trace.json" : traceFile);
+            cout << "Press ENTER to continue." << endl;
             break;
-        case 8:
+        }
+        case 11:
             cout << "Exiting program..." << endl;
             break;
         default:
@@ -1015,12 +8104,139 @@ int main() {
         // This clears any extra input that the user might have entered beyond the first number.
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-    } while (choice != 8);
+    } while (choice != 11);
 
     // Cleanup memory and save data
-    for (auto& item : items) {
-        delete item;
+    checkpointer.reset(); // Stop background saves before the final one
+    if (!save()) {
+        cout << "Warning: could not save data, the previous files were kept." << endl;
     }
+    showLatencyStats(); // Session summary
+    store.clear();
 
     return 0;
+}
+
+// Replays a recorded session against a copy of the data file (with the progress history and goal
+// tree next to it) in a scratch directory, as fast as possible and with the menu output discarded,
+// then prints the slowest inputs and the per-operation latency statistics. Recorded passwords are
+// replaced by password; without one the unlocks take the wrong-password path.
+int replaySession(const string& sessionFile, const string& dataFile, const string& timingsFile, const string& password) {
+    ifstream in(sessionFile);
+    if (!in) {
+        cout << "Error: could not open the session file " << sessionFile << endl;
+        return 1;
+    }
+    vector<string> options;
+    vector<ReplayBuffer::Input> inputs;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line[0] == '#') {
+            options = split(line.substr(1), ' ');
+            options.erase(remove(options.begin(), options.end(), ""), options.end());
+            continue;
+        }
+        size_t tab = line.find('\t');
+        if (tab != string::npos) {
+            bool redacted = tab > 0 && line[tab - 1] == '*';
+            inputs.push_back({ stoull(line.substr(0, tab)), redacted ? password : line.substr(tab + 1), redacted });
+        }
+    }
+
+    filesystem::path original = filesystem::current_path();
+    filesystem::path scratch = filesystem::temp_directory_path() / ("gtn_replay_" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    filesystem::path dataDirectory = filesystem::absolute(dataFile).parent_path();
+    error_code error;
+    filesystem::create_directories(scratch, error);
+    filesystem::copy_file(dataFile, scratch / "data.txt", error);
+    if (error) {
+        cout << "Error: could not copy " << dataFile << " to " << scratch.string() << ": " << error.message() << endl;
+        return 1;
+    }
+    for (const char* file : { "progress_history.txt", "goal_tree.txt" }) {
+        filesystem::copy_file(dataDirectory / file, scratch / file, error); // Optional
+    }
+    // Recorded paths must not be written to: segments are imported from the data copy under scratch
+    for (size_t i = 0; i + 1 < options.size(); i++) {
+        if (options[i] == "--segments") {
+            options[i + 1] = "segments";
+        }
+        else if (options[i] == "--record") {
+            options.erase(options.begin() + i, options.begin() + i + 2);
+            i--;
+        }
+    }
+
+    ReplayBuffer replay(inputs);
+    DiscardBuffer discard;
+    streambuf* input = cin.rdbuf(&replay);
+    streambuf* console = cout.rdbuf(&discard);
+    filesystem::current_path(scratch);
+    auto start = chrono::steady_clock::now();
+    int result = 1;
+    string failure;
+    try {
+        result = runInteractive(options);
+    }
+    catch (const exception& e) {
+        failure = e.what(); // E.g. a recorded option with a bad value
+    }
+    double elapsed = secondsSince(start);
+    replay.finish();
+    filesystem::current_path(original);
+    cout.rdbuf(console);
+    cin.rdbuf(input);
+    filesystem::remove_all(scratch, error);
+    if (!failure.empty()) {
+        cout << "Error: the replay stopped: " << failure << endl;
+        return 1;
+    }
+
+    uint64_t recordedMs = inputs.empty() ? 0 : inputs.back().recordedMs;
+    cout << "Replayed " << inputs.size() << " inputs of " << sessionFile << " against " << dataFile << " in " << fixed << setprecision(3) << elapsed
+        << " s (recorded session: " << recordedMs / 1000.0 << " s)\n\nSlowest inputs:\n";
+    vector<const ReplayBuffer::Input*> slowest;
+    for (const ReplayBuffer::Input& replayed : replay.getInputs()) {
+        slowest.push_back(&replayed);
+    }
+    sort(slowest.begin(), slowest.end(), [](const ReplayBuffer::Input* a, const ReplayBuffer::Input* b) { return a->seconds > b->seconds; });
+    for (size_t i = 0; i < min<size_t>(10, slowest.size()); i++) {
+        const ReplayBuffer::Input& replayed = *slowest[i];
+        cout << right << "  input " << setw(5) << &replayed - &replay.getInputs()[0] + 1 << " at " << setw(9) << setprecision(1) << replayed.recordedMs / 1000.0
+            << " s  " << setw(10) << formatLatency(static_cast<uint64_t>(replayed.seconds * 1e9)) << "  " << left << (replayed.redacted ? "(password)" : "\"" + replayed.text + "\"") << "\n";
+    }
+    cout << "\n";
+    showLatencyStats();
+
+    if (!timingsFile.empty()) {
+        ofstream csv(timingsFile);
+        csv << "input,recorded_ms,replay_seconds,text\n" << setprecision(9);
+        for (size_t i = 0; i < replay.getInputs().size(); i++) {
+            const ReplayBuffer::Input& replayed = replay.getInputs()[i];
+            string text = replayed.redacted ? "(password)" : replayed.text;
+            replace(text.begin(), text.end(), ',', ';');
+            csv << i + 1 << "," << replayed.recordedMs << "," << replayed.seconds << "," << text << "\n";
+        }
+        cout << (csv ? "Timings written to " : "Could not write ") << timingsFile << endl;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    traceNow(); // Trace timestamps count from here
+    traceThreadName("main");
+    vector<string> args(argv + 1, argv + argc);
+    if (args.size() >= 2 && args[0] == "replay") {
+        string password = "replay: password not recorded"; // Fails every unlock
+        auto option = find(args.begin(), args.end(), "--replay-password");
+        if (option != args.end() && option + 1 != args.end()) {
+            password = *(option + 1);
+            args.erase(option, option + 2);
+        }
+        return replaySession(args[1], args.size() >= 3 ? args[2] : "data.txt", args.size() >= 4 ? args[3] : "", password);
+    }
+    if (!args.empty() && args[0].compare(0, 2, "--") != 0) {
+        return runBatchCommand(args);
+    }
+    return runInteractive(args);
 }
\ No newline at end of file